@@ -171,6 +171,27 @@ INSERT INTO varlena_bug VALUES (repeat('Test', 250));
 ALTER TABLE varlena_bug ALTER COLUMN v SET STORAGE extended;
 SELECT bt_index_check('varlena_bug_idx', true);
 
+-- Check sorted insertions into the middle of an existing index, which can
+-- reuse the previously used leaf page instead of descending the tree
+CREATE TABLE bttest_inorder (id int8);
+INSERT INTO bttest_inorder SELECT i * 10 FROM generate_series(1, 10000) i;
+CREATE INDEX bttest_inorder_idx ON bttest_inorder (id);
+INSERT INTO bttest_inorder
+  SELECT i FROM generate_series(20001, 60000) i WHERE i % 10 <> 0;
+INSERT INTO bttest_inorder VALUES (70001), (70002), (70003), (70004), (70005);
+COPY bttest_inorder FROM stdin;
+80001
+80002
+80003
+80004
+80005
+\.
+-- Descending order, where the cached leaf page is never the right one
+INSERT INTO bttest_inorder
+  SELECT i FROM generate_series(90009, 80011, -1) i WHERE i % 10 <> 0;
+SELECT bt_index_check('bttest_inorder_idx', true);
+SELECT bt_index_parent_check('bttest_inorder_idx', true, true);
+
 -- cleanup
 DROP TABLE bttest_a;
 DROP TABLE bttest_b;
@@ -182,3 +203,4 @@ DROP TABLE bttest_unique_nulls;
 DROP OWNED BY regress_bttest_role; -- permissions
 DROP ROLE regress_bttest_role;
 DROP TABLE varlena_bug;
+DROP TABLE bttest_inorder;
@@ -0,0 +1,57 @@
+# Copyright (c) 2025, PostgreSQL Global Development Group
+
+# Check that with buffer_replacement_policy = 2q, pages that only cycled
+# through a buffer access strategy ring are not treated as re-used when they
+# are read back in.
+use strict;
+use warnings FATAL => 'all';
+use PostgreSQL::Test::Cluster;
+use PostgreSQL::Test::Utils;
+use Test::More;
+
+my $node = PostgreSQL::Test::Cluster->new('main');
+$node->init;
+$node->append_conf(
+	'postgresql.conf', qq{
+shared_buffers = 16MB
+buffer_replacement_policy = 2q
+autovacuum = off
+});
+$node->start;
+
+# A table well above a quarter of shared_buffers, so that sequential scans
+# of it use a ring of buffers.
+$node->safe_psql(
+	'postgres', q{
+	CREATE EXTENSION pg_buffercache;
+	CREATE TABLE ring_test AS
+		SELECT i, repeat('x', 500) AS filler FROM generate_series(1, 40000) i;
+});
+
+# Start over with empty shared buffers and ghost history, as loading the
+# table went through the clock sweep.
+$node->restart;
+
+# Cycle every page of the table through the ring.
+$node->safe_psql('postgres', 'SELECT count(*) FROM ring_test');
+
+# Read the first pages again, this time without a ring.
+my $tids = join(',', map { "\"($_,1)\"" } 0 .. 9);
+my $result = $node->safe_psql(
+	'postgres', qq{
+	SET enable_seqscan = off;
+	SELECT count(*) FROM ring_test WHERE ctid = ANY ('{$tids}'::tid[]);});
+is($result, '10', 'pages read again through a TID scan');
+
+$result = $node->safe_psql(
+	'postgres', q{
+	SELECT count(*), count(*) FILTER (WHERE usagecount > 1)
+	FROM pg_buffercache
+	WHERE relfilenode = pg_relation_filenode('ring_test')
+	  AND relblocknumber < 10});
+is($result, '10|0',
+	'pages evicted from a strategy ring start on probation when read again');
+
+$node->stop;
+
+done_testing();
@@ -164,6 +164,27 @@ commit;
 select * from pg_visibility_map('copyfreeze');
 select * from pg_check_frozen('copyfreeze');
 
+-- check that the second heap pass of a parallel vacuum, which is shared with
+-- the parallel workers, leaves every page all-visible
+set max_parallel_maintenance_workers = 2;
+set min_parallel_index_scan_size = 0;
+set min_parallel_table_scan_size = 0;
+create table vacuum_parallel_test (a int) with (autovacuum_enabled = off);
+insert into vacuum_parallel_test select generate_series(1, 100000);
+create index on vacuum_parallel_test (a);
+create index on vacuum_parallel_test ((a + 1));
+create index on vacuum_parallel_test ((a + 2));
+delete from vacuum_parallel_test where a % 3 = 0;
+vacuum (parallel 2) vacuum_parallel_test;
+select count(*) from vacuum_parallel_test;
+select all_visible = pg_relation_size('vacuum_parallel_test') /
+  current_setting('block_size')::int as all_pages_visible
+  from pg_visibility_map_summary('vacuum_parallel_test');
+select * from pg_check_visible('vacuum_parallel_test'); -- hopefully none
+reset max_parallel_maintenance_workers;
+reset min_parallel_index_scan_size;
+reset min_parallel_table_scan_size;
+
 -- cleanup
 drop table test_partitioned;
 drop view test_view;
@@ -174,3 +195,4 @@ drop foreign data wrapper dummy;
 drop materialized view matview_visibility_test;
 drop table regular_table;
 drop table copyfreeze;
+drop table vacuum_parallel_test;
@@ -16,8 +16,10 @@
 #include "postgres.h"
 
 #include "access/printtup.h"
+#include "libpq/libpq.h"
 #include "libpq/pqformat.h"
 #include "libpq/protocol.h"
+#include "mb/pg_wchar.h"
 #include "tcop/pquery.h"
 #include "utils/lsyscache.h"
 #include "utils/memdebug.h"
@@ -30,6 +32,19 @@ static bool printtup(TupleTableSlot *slot, DestReceiver *self);
 static void printtup_shutdown(DestReceiver *self);
 static void printtup_destroy(DestReceiver *self);
 
+/*
+ * Attribute values at least this large are sent to the client directly from
+ * the output function's result, rather than being copied into the DataRow
+ * message buffer first; see printtup_append_data().
+ */
+#define PRINTTUP_REF_THRESHOLD	(32 * 1024)
+
+/*
+ * Maximum number of values sent by reference per DataRow message.  Each one
+ * needs an iovec of its own, plus one for the buffered data following it.
+ */
+#define PRINTTUP_MAX_REFS	((PG_IOV_MAX - 1) / 2)
+
 /* ----------------------------------------------------------------
  *		printtup / debugtup support
  * ----------------------------------------------------------------
@@ -51,6 +66,13 @@ typedef struct
 	FmgrInfo	finfo;			/* Precomputed call info for output fn */
 } PrinttupAttrInfo;
 
+typedef struct
+{								/* Attribute value sent by reference */
+	int			offset;			/* where it goes in the buffered data */
+	const char *data;			/* the value, in per-row memory */
+	int			len;			/* its length in bytes */
+} PrinttupDataRef;
+
 typedef struct
 {
 	DestReceiver pub;			/* publicly-known function pointers */
@@ -61,6 +83,9 @@ typedef struct
 	PrinttupAttrInfo *myinfo;	/* Cached info about each attr */
 	StringInfoData buf;			/* output buffer (*not* in tmpcontext) */
 	MemoryContext tmpcontext;	/* Memory context for per-row workspace */
+	int			nrefs;			/* number of valid entries in refs[] */
+	Size		reflen;			/* total length of data in refs[] */
+	PrinttupDataRef refs[PRINTTUP_MAX_REFS];	/* large values in this row */
 } DR_printtup;
 
 /* ----------------
@@ -293,6 +318,78 @@ printtup_prepare_info(DR_printtup *myState, TupleDesc typeinfo, int numAttrs)
 	}
 }
 
+/*
+ * Append an attribute value to the DataRow message being built.
+ *
+ * Large values are not copied into the message buffer; we just remember
+ * where they belong, and printtup_end_message() hands them to the
+ * communication layer along with the buffered data as a vector of buffers.
+ * The value must therefore stay valid until the message has been sent.
+ */
+static void
+printtup_append_data(DR_printtup *myState, const char *data, int len)
+{
+	StringInfo	buf = &myState->buf;
+
+	if (len >= PRINTTUP_REF_THRESHOLD &&
+		myState->nrefs < PRINTTUP_MAX_REFS &&
+		buf->len + myState->reflen + len < MaxAllocSize)
+	{
+		PrinttupDataRef *ref = &myState->refs[myState->nrefs++];
+
+		ref->offset = buf->len;
+		ref->data = data;
+		ref->len = len;
+		myState->reflen += len;
+	}
+	else
+		pq_sendbytes(buf, data, len);
+}
+
+/*
+ * Send the DataRow message built by printtup, including any values that
+ * printtup_append_data() left out of the message buffer.
+ */
+static void
+printtup_end_message(DR_printtup *myState)
+{
+	StringInfo	buf = &myState->buf;
+	struct iovec iov[PG_IOV_MAX];
+	int			iovcnt = 0;
+	int			offset = 0;
+
+	if (myState->nrefs == 0)
+	{
+		pq_endmessage_reuse(buf);
+		return;
+	}
+
+	for (int i = 0; i < myState->nrefs; i++)
+	{
+		PrinttupDataRef *ref = &myState->refs[i];
+
+		if (ref->offset > offset)
+		{
+			iov[iovcnt].iov_base = buf->data + offset;
+			iov[iovcnt].iov_len = ref->offset - offset;
+			iovcnt++;
+			offset = ref->offset;
+		}
+		iov[iovcnt].iov_base = unconstify(char *, ref->data);
+		iov[iovcnt].iov_len = ref->len;
+		iovcnt++;
+	}
+	if (buf->len > offset)
+	{
+		iov[iovcnt].iov_base = buf->data + offset;
+		iov[iovcnt].iov_len = buf->len - offset;
+		iovcnt++;
+	}
+
+	/* msgtype was saved in cursor field by pq_beginmessage_reuse */
+	(void) pq_putmessagev(buf->cursor, iov, iovcnt);
+}
+
 /* ----------------
  *		printtup --- send a tuple to the client
  *
@@ -324,6 +421,8 @@ printtup(TupleTableSlot *slot, DestReceiver *self)
 	 * Prepare a DataRow message (note buffer is in per-query context)
 	 */
 	pq_beginmessage_reuse(buf, PqMsg_DataRow);
+	myState->nrefs = 0;
+	myState->reflen = 0;
 
 	pq_sendint16(buf, natts);
 
@@ -356,9 +455,22 @@ printtup(TupleTableSlot *slot, DestReceiver *self)
 		{
 			/* Text output */
 			char	   *outputstr;
+			int			slen;
 
 			outputstr = OutputFunctionCall(&thisState->finfo, attr);
-			pq_sendcountedtext(buf, outputstr, strlen(outputstr));
+			slen = strlen(outputstr);
+			if (slen >= PRINTTUP_REF_THRESHOLD)
+			{
+				/* Same as pq_sendcountedtext, but try to avoid the copy */
+				char	   *p = pg_server_to_client(outputstr, slen);
+
+				if (p != outputstr) /* actual conversion has been done? */
+					slen = strlen(p);
+				pq_sendint32(buf, slen);
+				printtup_append_data(myState, p, slen);
+			}
+			else
+				pq_sendcountedtext(buf, outputstr, slen);
 		}
 		else
 		{
@@ -367,12 +479,12 @@ printtup(TupleTableSlot *slot, DestReceiver *self)
 
 			outputbytes = SendFunctionCall(&thisState->finfo, attr);
 			pq_sendint32(buf, VARSIZE(outputbytes) - VARHDRSZ);
-			pq_sendbytes(buf, VARDATA(outputbytes),
-						 VARSIZE(outputbytes) - VARHDRSZ);
+			printtup_append_data(myState, VARDATA(outputbytes),
+								 VARSIZE(outputbytes) - VARHDRSZ);
 		}
 	}
 
-	pq_endmessage_reuse(buf);
+	printtup_end_message(myState);
 
 	/* Return to caller's context, and flush row's temporary memory */
 	MemoryContextSwitchTo(oldcontext);
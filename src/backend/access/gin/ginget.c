@@ -795,6 +795,56 @@ entryLoadMoreItems(GinState *ginstate, GinScanEntry entry,
 #define gin_rand() pg_prng_double(&pg_global_prng_state)
 #define dropItem(e) ( gin_rand() > ((double)GinFuzzySearchLimit)/((double)((e)->predictNumberResult)) )
 
+/*
+ * Return the index of the first item in list[start .. nitems - 1] that is
+ * greater than 'key', or nitems if there is none.
+ *
+ * When the entries of a scan key are intersected, a rare entry often lets a
+ * frequent one skip over a long run of items at once.  Rather than stepping
+ * over them one by one, gallop: probe exponentially growing distances ahead
+ * to bracket the target, then binary search within the bracket.  Skipping d
+ * items costs O(log d) comparisons, and advancing by a single item, which is
+ * the common case, costs no more than before.
+ */
+static inline int
+gallopPastItem(ItemPointerData *list, int start, int nitems, ItemPointer key)
+{
+	int			lo = start;
+	int			hi;
+	int			step = 1;
+
+	if (lo >= nitems || ginCompareItemPointers(&list[lo], key) > 0)
+		return lo;
+
+	/* list[lo] <= key; find hi such that hi == nitems or list[hi] > key */
+	for (;;)
+	{
+		hi = lo + step;
+		if (hi >= nitems)
+		{
+			hi = nitems;
+			break;
+		}
+		if (ginCompareItemPointers(&list[hi], key) > 0)
+			break;
+		lo = hi;
+		step *= 2;
+	}
+
+	/* the answer lies in (lo, hi] */
+	while (hi - lo > 1)
+	{
+		int			mid = lo + (hi - lo) / 2;
+
+		if (ginCompareItemPointers(&list[mid], key) > 0)
+			hi = mid;
+		else
+			lo = mid;
+	}
+
+	return hi;
+}
+
 /*
  * Sets entry->curItem to next heap item pointer > advancePast, for one entry
  * of one scan key, or sets entry->isFinished to true if there are no more.
@@ -926,6 +976,10 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 		 */
 		for (;;)
 		{
+			/* Skip over any items <= advancePast */
+			entry->offset = gallopPastItem(entry->list, entry->offset,
+										   entry->nlist, &advancePast);
+
 			if (entry->offset >= entry->nlist)
 			{
 				ItemPointerSetInvalid(&entry->curItem);
@@ -935,10 +989,6 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 
 			entry->curItem = entry->list[entry->offset++];
 
-			/* If we're not past advancePast, keep scanning */
-			if (ginCompareItemPointers(&entry->curItem, &advancePast) <= 0)
-				continue;
-
 			/* Done unless we need to reduce the result */
 			if (!entry->reduceResult || !dropItem(entry))
 				break;
@@ -949,8 +999,12 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 		/* A posting tree */
 		for (;;)
 		{
+			/* Skip over any items <= advancePast in the current batch */
+			entry->offset = gallopPastItem(entry->list, entry->offset,
+										   entry->nlist, &advancePast);
+
 			/* If we've processed the current batch, load more items */
-			while (entry->offset >= entry->nlist)
+			if (entry->offset >= entry->nlist)
 			{
 				entryLoadMoreItems(ginstate, entry, advancePast);
 
@@ -959,14 +1013,11 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 					ItemPointerSetInvalid(&entry->curItem);
 					return;
 				}
+				continue;
 			}
 
 			entry->curItem = entry->list[entry->offset++];
 
-			/* If we're not past advancePast, keep scanning */
-			if (ginCompareItemPointers(&entry->curItem, &advancePast) <= 0)
-				continue;
-
 			/* Done unless we need to reduce the result */
 			if (!entry->reduceResult || !dropItem(entry))
 				break;
@@ -1223,10 +1223,14 @@ AssertCheckGinBuffer(GinBuffer *buffer)
  * (we process the data sorted), so we know when we received all data for
  * a given key.
  *
+ * mem_kb is the memory budget of the process, in kilobytes.  The TID array
+ * gets a fraction of it, because the process is also running a tuplesort
+ * within the same budget.
+ *
  * Initializes sort support procedures for all index attributes.
  */
 static GinBuffer *
-GinBufferInit(Relation index)
+GinBufferInit(Relation index, int mem_kb)
 {
 	GinBuffer  *buffer = palloc0(sizeof(GinBuffer));
 	int			i,
@@ -1234,11 +1238,17 @@ GinBufferInit(Relation index)
 	TupleDesc	desc = RelationGetDescr(index);
 
 	/*
-	 * How many items can we fit into the memory limit? We don't want to end
-	 * with too many TIDs. and 64kB seems more than enough. But maybe this
-	 * should be tied to maintenance_work_mem or something like that?
+	 * How many items can we fit into the memory limit?  Every time the
+	 * buffer fills up for a frequent key, we have to insert the TIDs we have
+	 * so far into the index, and each such insertion has to find and modify
+	 * the key's existing posting list or posting tree, so a larger buffer
+	 * means fewer insertions.  But we don't want to end up with too many
+	 * TIDs either, as long lists make the mergesorts in GinBufferStoreTuple
+	 * more expensive (see GinBufferShouldTrim).  So use a sixteenth of the
+	 * memory budget, but between 64kB and 1MB.
 	 */
-	buffer->maxitems = (64 * 1024L) / sizeof(ItemPointerData);
+	buffer->maxitems = Min(Max((Size) mem_kb * 1024 / 16, 64 * 1024),
+						   1024 * 1024) / sizeof(ItemPointerData);
 
 	nKeys = IndexRelationGetNumberOfKeyAttributes(index);
 
@@ -1492,10 +1502,11 @@ GinBufferStoreTuple(GinBuffer *buffer, GinTuple *tup)
 		 * still pass 0 as number of elements in that array though.
 		 */
 		if (buffer->items == NULL)
-			buffer->items = palloc((buffer->nitems + tup->nitems) * sizeof(ItemPointerData));
+			buffer->items = palloc_extended((buffer->nitems + tup->nitems) * sizeof(ItemPointerData),
+											MCXT_ALLOC_HUGE);
 		else
-			buffer->items = repalloc(buffer->items,
-									 (buffer->nitems + tup->nitems) * sizeof(ItemPointerData));
+			buffer->items = repalloc_huge(buffer->items,
+										  (buffer->nitems + tup->nitems) * sizeof(ItemPointerData));
 
 		new = ginMergeItemPointers(&buffer->items[buffer->nfrozen], /* first unfrozen */
 								   (buffer->nitems - buffer->nfrozen),	/* num of unfrozen */
@@ -1634,9 +1645,10 @@ _gin_parallel_merge(GinBuildState *state)
 	 * Initialize buffer to combine entries for the same key.
 	 *
 	 * The leader is allowed to use the whole maintenance_work_mem buffer to
-	 * combine data. The parallel workers already completed.
+	 * combine data, but its tuplesort is still using it for the final merge.
+	 * The parallel workers already completed.
 	 */
-	buffer = GinBufferInit(state->ginstate.index);
+	buffer = GinBufferInit(state->ginstate.index, maintenance_work_mem);
 
 	/*
 	 * Set the progress target for the next phase.  Reset the block number
@@ -1831,7 +1843,7 @@ _gin_process_worker_data(GinBuildState *state, Tuplesortstate *worker_sort,
 	 * in ginBuildCallbackParallel. But this probably should be the 32MB used
 	 * during planning, just like there.
 	 */
-	buffer = GinBufferInit(state->ginstate.index);
+	buffer = GinBufferInit(state->ginstate.index, state->work_mem);
 
 	/* sort the raw per-worker data */
 	if (progress)
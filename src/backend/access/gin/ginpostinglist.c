@@ -300,26 +300,25 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 	int			nallocated;
 	uint64		val;
 	char	   *endseg = ((char *) segment) + len;
+	GinPostingList *seg;
 	int			ndecoded;
 	unsigned char *ptr;
 	unsigned char *endptr;
 
 	/*
-	 * Guess an initial size of the array.
+	 * Every item takes at least one byte, besides the first item of each
+	 * segment, which is stored in the segment header.  Summing that over the
+	 * segment headers gives an upper bound on the number of items, so we can
+	 * size the array up front and keep the decoding loop free of checks.
 	 */
-	nallocated = segment->nbytes * 2 + 1;
+	nallocated = 0;
+	for (seg = segment; (char *) seg < endseg; seg = GinNextPostingListSegment(seg))
+		nallocated += seg->nbytes + 1;
 	result = palloc(nallocated * sizeof(ItemPointerData));
 
 	ndecoded = 0;
 	while ((char *) segment < endseg)
 	{
-		/* enlarge output array if needed */
-		if (ndecoded >= nallocated)
-		{
-			nallocated *= 2;
-			result = repalloc(result, nallocated * sizeof(ItemPointerData));
-		}
-
 		/* copy the first item */
 		Assert(OffsetNumberIsValid(ItemPointerGetOffsetNumber(&segment->first)));
 		Assert(ndecoded == 0 || ginCompareItemPointers(&segment->first, &result[ndecoded - 1]) > 0);
@@ -331,14 +330,16 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 		endptr = segment->bytes + segment->nbytes;
 		while (ptr < endptr)
 		{
-			/* enlarge output array if needed */
-			if (ndecoded >= nallocated)
-			{
-				nallocated *= 2;
-				result = repalloc(result, nallocated * sizeof(ItemPointerData));
-			}
+			Assert(ndecoded < nallocated);
 
-			val += decode_varbyte(&ptr);
+			/*
+			 * Deltas between neighboring items on the same heap page fit in a
+			 * single byte, so handle that case inline.
+			 */
+			if (likely(*ptr < 0x80))
+				val += *(ptr++);
+			else
+				val += decode_varbyte(&ptr);
 
 			uint64_to_itemptr(val, &result[ndecoded]);
 			ndecoded++;
@@ -23,6 +23,13 @@
 #include "storage/freespace.h"
 #include "storage/lmgr.h"
 
+/*
+ * Maximum number of pages with free space that RelationGetBufferForTuple()
+ * passes over because another backend holds their lock, before it waits for
+ * a lock instead.
+ */
+#define MAX_SKIPPED_TARGET_BLOCKS	4
+
 
 /*
  * RelationPutHeapTuple - place tuple at specified page
@@ -300,6 +307,29 @@ RelationAddBlocks(Relation relation, BulkInsertState bistate,
 		if (bistate)
 			extend_by_pages = Max(extend_by_pages, bistate->already_extended_by);
 
+		/*
+		 * A bistate only remembers previous extensions within the same
+		 * statement, and without one there's no memory at all, yet many
+		 * backends each inserting a few rows per statement can contend just
+		 * as badly.  So also remember how much we extended by in the
+		 * SMgrRelation, which outlives the statement.  While there are
+		 * waiters, keep doubling the amount, so that the lock is taken less
+		 * and less often; otherwise decay it, so that we don't keep bloating
+		 * a relation that isn't contended anymore.  This only works if the
+		 * additional pages can be found via the FSM.
+		 */
+		if (use_fsm)
+		{
+			SMgrRelation reln = RelationGetSmgr(relation);
+
+			extend_by_pages = Max(extend_by_pages, reln->smgr_extend_by);
+			if (waitcount > 0)
+				reln->smgr_extend_by = Min(extend_by_pages * 2,
+										   MAX_BUFFERS_TO_EXTEND_BY);
+			else
+				reln->smgr_extend_by /= 2;
+		}
+
 		/*
 		 * Can't extend by more than MAX_BUFFERS_TO_EXTEND_BY, we need to pin
 		 * them all concurrently.
@@ -516,6 +546,7 @@ RelationGetBufferForTuple(Relation relation, Size len,
 				otherBlock;
 	bool		unlockedTargetBuffer;
 	bool		recheckVmPins;
+	int			nskipped = 0;
 
 	len = MAXALIGN(len);		/* be conservative */
 
@@ -627,7 +658,36 @@ loop:
 				(PageGetMaxOffsetNumber(BufferGetPage(buffer)) == 0))
 				visibilitymap_pin(relation, targetBlock, vmbuffer);
 
-			LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
+			/*
+			 * With many backends inserting concurrently, they tend to pick
+			 * the same target page, from the FSM or because they extended
+			 * the relation at about the same time, and then queue up on its
+			 * content lock.  If the lock isn't immediately available, ask
+			 * the FSM for a different page instead of waiting.  The FSM
+			 * advances its search start point on every search, so repeated
+			 * requests spread the inserters across the pages with free
+			 * space, and since we remember the page we end up using as our
+			 * target block, each backend tends to stick to its own page.
+			 * Don't do this too often, though; if all candidate pages are
+			 * busy, it's better to wait than to search forever.
+			 */
+			if (bistate != NULL || !use_fsm ||
+				nskipped >= MAX_SKIPPED_TARGET_BLOCKS)
+				LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
+			else if (!ConditionalLockBuffer(buffer))
+			{
+				BlockNumber newBlock;
+
+				nskipped++;
+				newBlock = GetPageWithFreeSpace(relation, targetFreeSpace);
+				if (newBlock != InvalidBlockNumber && newBlock != targetBlock)
+				{
+					ReleaseBuffer(buffer);
+					targetBlock = newBlock;
+					continue;
+				}
+				LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
+			}
 		}
 		else if (otherBlock == targetBlock)
 		{
@@ -25,8 +25,9 @@
  * been referred to colloquially as phases for so long that they are referred
  * to as such here.
  *
- * Manually invoked VACUUMs may scan indexes during phase II in parallel. For
- * more information on this, see the comment at the top of vacuumparallel.c.
+ * Manually invoked VACUUMs may scan indexes during phase II in parallel, and
+ * share phase III with the same parallel workers. For more information on
+ * this, see the comment at the top of vacuumparallel.c.
  *
  * In between phases, vacuum updates the freespace map (every
  * VACUUM_FSM_EVERY_PAGES).
@@ -135,6 +136,7 @@
 #include "access/heapam.h"
 #include "access/htup_details.h"
 #include "access/multixact.h"
+#include "access/parallel.h"
 #include "access/tidstore.h"
 #include "access/transam.h"
 #include "access/visibilitymap.h"
@@ -348,6 +350,9 @@ typedef struct LVRelState
 
 	/* Instrumentation counters */
 	int			num_index_scans;
+	int			num_parallel_heap_passes;	/* # heap passes shared with
+											 * parallel workers */
+	BlockNumber worker_vacuumed_pages;	/* # pages vacuumed by those workers */
 	/* Counters that follow are only for scanned_pages */
 	int64		tuples_deleted; /* # deleted from table */
 	int64		tuples_frozen;	/* # newly frozen */
@@ -419,6 +424,17 @@ typedef struct LVSavedErrInfo
 	VacErrPhase phase;
 } LVSavedErrInfo;
 
+/*
+ * Callback state for vacuum_reap_lp_read_stream_next().  pvs is set when the
+ * second pass over the heap is shared with parallel vacuum workers, in which
+ * case only the blocks claimed by this process are returned.
+ */
+typedef struct LVReapState
+{
+	TidStoreIter *iter;
+	ParallelVacuumState *pvs;
+} LVReapState;
+
 
 /* non-export function prototypes */
 static void lazy_scan_heap(LVRelState *vacrel);
@@ -441,6 +457,8 @@ static bool lazy_scan_noprune(LVRelState *vacrel, Buffer buf,
 static void lazy_vacuum(LVRelState *vacrel);
 static bool lazy_vacuum_all_indexes(LVRelState *vacrel);
 static void lazy_vacuum_heap_rel(LVRelState *vacrel);
+static BlockNumber lazy_vacuum_heap_pass(LVRelState *vacrel,
+										 ParallelVacuumState *pvs);
 static void lazy_vacuum_heap_page(LVRelState *vacrel, BlockNumber blkno,
 								  Buffer buffer, OffsetNumber *deadoffsets,
 								  int num_offsets, Buffer vmbuffer);
@@ -747,6 +765,8 @@ heap_vacuum_rel(Relation rel, const VacuumParams params,
 
 	/* Initialize remaining counters (be tidy) */
 	vacrel->num_index_scans = 0;
+	vacrel->num_parallel_heap_passes = 0;
+	vacrel->worker_vacuumed_pages = 0;
 	vacrel->tuples_deleted = 0;
 	vacrel->tuples_frozen = 0;
 	vacrel->lpdead_items = 0;
@@ -1087,6 +1107,10 @@ heap_vacuum_rel(Relation rel, const VacuumParams params,
 							 orig_rel_pages == 0 ? 100.0 :
 							 100.0 * vacrel->lpdead_item_pages / orig_rel_pages,
 							 vacrel->lpdead_items);
+			if (vacrel->num_parallel_heap_passes > 0)
+				appendStringInfo(&buf,
+								 _("parallel heap vacuuming: %u pages vacuumed by parallel workers\n"),
+								 vacrel->worker_vacuumed_pages);
 			for (int i = 0; i < vacrel->nindexes; i++)
 			{
 				IndexBulkDeleteResult *istat = vacrel->indstats[i];
@@ -2674,7 +2698,8 @@ lazy_vacuum_all_indexes(LVRelState *vacrel)
 /*
  * Read stream callback for vacuum's third phase (second pass over the heap).
  * Gets the next block from the TID store and returns it or InvalidBlockNumber
- * if there are no further blocks to vacuum.
+ * if there are no further blocks to vacuum.  In a parallel pass, blocks that
+ * belong to other participants are skipped.
  *
  * NB: Assumed to be safe to use with READ_STREAM_USE_BATCHING.
  */
@@ -2683,12 +2708,16 @@ vacuum_reap_lp_read_stream_next(ReadStream *stream,
 								void *callback_private_data,
 								void *per_buffer_data)
 {
-	TidStoreIter *iter = callback_private_data;
+	LVReapState *state = callback_private_data;
 	TidStoreIterResult *iter_result;
 
-	iter_result = TidStoreIterateNext(iter);
-	if (iter_result == NULL)
-		return InvalidBlockNumber;
+	do
+	{
+		iter_result = TidStoreIterateNext(state->iter);
+		if (iter_result == NULL)
+			return InvalidBlockNumber;
+	} while (state->pvs != NULL &&
+			 !parallel_vacuum_claim_heap_block(state->pvs, iter_result->blkno));
 
 	/*
 	 * Save the TidStoreIterResult for later, so we can extract the offsets.
@@ -2719,11 +2748,9 @@ vacuum_reap_lp_read_stream_next(ReadStream *stream,
 static void
 lazy_vacuum_heap_rel(LVRelState *vacrel)
 {
-	ReadStream *stream;
-	BlockNumber vacuumed_pages = 0;
-	Buffer		vmbuffer = InvalidBuffer;
+	BlockNumber vacuumed_pages;
+	int			nworkers = 0;
 	LVSavedErrInfo saved_err_info;
-	TidStoreIter *iter;
 
 	Assert(vacrel->do_index_vacuuming);
 	Assert(vacrel->do_index_cleanup);
@@ -2738,15 +2765,78 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 							 VACUUM_ERRCB_PHASE_VACUUM_HEAP,
 							 InvalidBlockNumber, InvalidOffsetNumber);
 
-	iter = TidStoreBeginIterate(vacrel->dead_items);
+	/*
+	 * Share the pass with parallel vacuum workers, if we have them.  The
+	 * number of pages with LP_DEAD items counts pages from all index scans
+	 * so far, but it's good enough to decide whether to bother.
+	 */
+	if (ParallelVacuumIsActive(vacrel))
+		nworkers = parallel_vacuum_heap_pass_begin(vacrel->pvs,
+												   vacrel->cutoffs.OldestXmin,
+												   vacrel->lpdead_item_pages);
+
+	vacuumed_pages = lazy_vacuum_heap_pass(vacrel,
+										   nworkers > 0 ? vacrel->pvs : NULL);
+
+	if (nworkers > 0)
+	{
+		BlockNumber worker_vacuumed_pages;
+		BlockNumber worker_new_visible_pages;
+		BlockNumber worker_new_visible_frozen_pages;
+
+		parallel_vacuum_heap_pass_end(vacrel->pvs,
+									  &worker_vacuumed_pages,
+									  &worker_new_visible_pages,
+									  &worker_new_visible_frozen_pages);
+		vacuumed_pages += worker_vacuumed_pages;
+		vacrel->num_parallel_heap_passes++;
+		vacrel->worker_vacuumed_pages += worker_vacuumed_pages;
+		vacrel->vm_new_visible_pages += worker_new_visible_pages;
+		vacrel->vm_new_visible_frozen_pages += worker_new_visible_frozen_pages;
+	}
+
+	/*
+	 * We set all LP_DEAD items from the first heap pass to LP_UNUSED during
+	 * the second heap pass.  No more, no less.
+	 */
+	Assert(vacrel->num_index_scans > 1 ||
+		   (vacrel->dead_items_info->num_items == vacrel->lpdead_items &&
+			vacuumed_pages == vacrel->lpdead_item_pages));
+
+	ereport(DEBUG2,
+			(errmsg("table \"%s\": removed %" PRId64 " dead item identifiers in %u pages",
+					vacrel->relname, vacrel->dead_items_info->num_items,
+					vacuumed_pages)));
+
+	/* Revert to the previous phase information for error traceback */
+	restore_vacuum_error_info(vacrel, &saved_err_info);
+}
+
+/*
+ *	lazy_vacuum_heap_pass() -- this process's share of the second heap pass
+ *
+ * Vacuums every block in vacrel->dead_items, or when pvs is given, only the
+ * blocks that this process claims; the other participants take the rest.
+ * Returns the number of pages vacuumed.
+ */
+static BlockNumber
+lazy_vacuum_heap_pass(LVRelState *vacrel, ParallelVacuumState *pvs)
+{
+	ReadStream *stream;
+	BlockNumber vacuumed_pages = 0;
+	Buffer		vmbuffer = InvalidBuffer;
+	LVReapState reap;
+
+	reap.iter = TidStoreBeginIterate(vacrel->dead_items);
+	reap.pvs = pvs;
 
 	/*
 	 * Set up the read stream for vacuum's second pass through the heap.
 	 *
 	 * It is safe to use batchmode, as vacuum_reap_lp_read_stream_next() does
-	 * not need to wait for IO and does not perform locking. Once we support
-	 * parallelism it should still be fine, as presumably the holder of locks
-	 * would never be blocked by IO while holding the lock.
+	 * not need to wait for IO and does not perform locking.  Claiming a
+	 * chunk of blocks in a parallel pass is a single atomic operation, which
+	 * is fine too.
 	 */
 	stream = read_stream_begin_relation(READ_STREAM_MAINTENANCE |
 										READ_STREAM_USE_BATCHING,
@@ -2754,7 +2844,7 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 										vacrel->rel,
 										MAIN_FORKNUM,
 										vacuum_reap_lp_read_stream_next,
-										iter,
+										&reap,
 										sizeof(TidStoreIterResult));
 
 	while (true)
@@ -2803,27 +2893,67 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 	}
 
 	read_stream_end(stream);
-	TidStoreEndIterate(iter);
+	TidStoreEndIterate(reap.iter);
 
 	vacrel->blkno = InvalidBlockNumber;
 	if (BufferIsValid(vmbuffer))
 		ReleaseBuffer(vmbuffer);
 
-	/*
-	 * We set all LP_DEAD items from the first heap pass to LP_UNUSED during
-	 * the second heap pass.  No more, no less.
-	 */
-	Assert(vacrel->num_index_scans > 1 ||
-		   (vacrel->dead_items_info->num_items == vacrel->lpdead_items &&
-			vacuumed_pages == vacrel->lpdead_item_pages));
+	return vacuumed_pages;
+}
 
-	ereport(DEBUG2,
-			(errmsg("table \"%s\": removed %" PRId64 " dead item identifiers in %u pages",
-					vacrel->relname, vacrel->dead_items_info->num_items,
-					vacuumed_pages)));
+/*
+ *	heap_vacuum_parallel_heap_pass() -- a parallel worker's share of the
+ *										second heap pass
+ *
+ * Called through the relation_vacuum_parallel_pass table AM callback in
+ * parallel vacuum workers launched by parallel_vacuum_heap_pass_begin().
+ * The worker has no LVRelState of its own, so we set up just enough of one
+ * to vacuum the blocks it claims, and return what it did for the leader to
+ * add to its counters.
+ */
+void
+heap_vacuum_parallel_heap_pass(Relation rel, ParallelVacuumState *pvs,
+							   TidStore *dead_items, TransactionId oldest_xmin,
+							   BufferAccessStrategy bstrategy,
+							   BlockNumber *vacuumed_pages,
+							   BlockNumber *new_visible_pages,
+							   BlockNumber *new_visible_frozen_pages)
+{
+	LVRelState *vacrel;
+	ErrorContextCallback errcallback;
 
-	/* Revert to the previous phase information for error traceback */
-	restore_vacuum_error_info(vacrel, &saved_err_info);
+	Assert(IsParallelWorker());
+
+	vacrel = (LVRelState *) palloc0(sizeof(LVRelState));
+	vacrel->rel = rel;
+	vacrel->bstrategy = bstrategy;
+	vacrel->do_index_vacuuming = true;
+	vacrel->cutoffs.OldestXmin = oldest_xmin;
+	vacrel->dead_items = dead_items;
+	vacrel->relnamespace = get_namespace_name(RelationGetNamespace(rel));
+	vacrel->relname = pstrdup(RelationGetRelationName(rel));
+	vacrel->indname = NULL;
+	vacrel->phase = VACUUM_ERRCB_PHASE_VACUUM_HEAP;
+	vacrel->blkno = InvalidBlockNumber;
+	vacrel->offnum = InvalidOffsetNumber;
+
+	/* Setup error traceback support for ereport() */
+	errcallback.callback = vacuum_error_callback;
+	errcallback.arg = vacrel;
+	errcallback.previous = error_context_stack;
+	error_context_stack = &errcallback;
+
+	*vacuumed_pages = lazy_vacuum_heap_pass(vacrel, pvs);
+	*new_visible_pages = vacrel->vm_new_visible_pages;
+	*new_visible_frozen_pages = vacrel->vm_new_visible_frozen_pages;
+
+	/* Pop the error context stack */
+	error_context_stack = errcallback.previous;
+
+	pfree(vacrel->relnamespace);
+	pfree(vacrel->relname);
+	pfree(vacrel);
 }
 
 /*
@@ -2848,7 +2978,15 @@ lazy_vacuum_heap_page(LVRelState *vacrel, BlockNumber blkno, Buffer buffer,
 
 	Assert(vacrel->do_index_vacuuming);
 
-	pgstat_progress_update_param(PROGRESS_VACUUM_HEAP_BLKS_VACUUMED, blkno);
+	/*
+	 * Only the leader reports progress.  A parallel worker's own progress
+	 * entry isn't the one being monitored for this VACUUM, and as every
+	 * participant claims chunks of blocks in increasing order, the block the
+	 * leader is on is never far behind the furthest block being vacuumed.
+	 */
+	if (!IsParallelWorker())
+		pgstat_progress_update_param(PROGRESS_VACUUM_HEAP_BLKS_VACUUMED,
+									 blkno);
 
 	/* Update error traceback information */
 	update_vacuum_error_info(vacrel, &saved_err_info,
@@ -29,6 +29,12 @@
 /* Minimum tree height for application of fastpath optimization */
 #define BTREE_FASTPATH_MIN_LEVEL	2
 
+/*
+ * Number of times the statement-level leaf page cache may fail before we
+ * demand that it succeeds at least as often as it fails
+ */
+#define BTREE_LEAFCACHE_MIN_MISSES	8
+
 
 static BTStack _bt_search_insert(Relation rel, Relation heaprel,
 								 BTInsertState insertstate);
@@ -92,6 +98,8 @@ static inline int _bt_blk_cmp(const void *arg1, const void *arg2);
  *		must nevertheless have a new entry to point to a successor
  *		version.
  *
+ *		cache is the statement-lifespan insertion cache, or NULL.
+ *
  *		The result value is only significant for UNIQUE_CHECK_PARTIAL:
  *		it must be true if the entry is known unique, else false.
  *		(In the current implementation we'll also return true after a
@@ -101,7 +109,7 @@ static inline int _bt_blk_cmp(const void *arg1, const void *arg2);
 bool
 _bt_doinsert(Relation rel, IndexTuple itup,
 			 IndexUniqueCheck checkUnique, bool indexUnchanged,
-			 Relation heapRel)
+			 Relation heapRel, BTInsertCache cache)
 {
 	bool		is_unique = false;
 	BTInsertStateData insertstate;
@@ -156,6 +164,7 @@ _bt_doinsert(Relation rel, IndexTuple itup,
 	insertstate.bounds_valid = false;
 	insertstate.buf = InvalidBuffer;
 	insertstate.postingoff = 0;
+	insertstate.cache = cache;
 
 search:
 
@@ -257,6 +266,8 @@ search:
 		 */
 		newitemoff = _bt_findinsertloc(rel, &insertstate, checkingunique,
 									   indexUnchanged, stack, heapRel);
+		if (cache)
+			cache->lastleaf = BufferGetBlockNumber(insertstate.buf);
 		_bt_insertonpg(rel, heapRel, itup_key, insertstate.buf, InvalidBuffer,
 					   stack, itup, insertstate.itemsz, newitemoff,
 					   insertstate.postingoff, false);
@@ -312,10 +323,25 @@ search:
  * rightmost page (we give up if we'd have to wait for the lock).  We assume
  * that it isn't useful to apply the optimization when there is contention,
  * since each per-backend cache won't stay valid for long.
+ *
+ * A second, similar optimization helps when a statement inserts many tuples
+ * in index order into the middle of the key space, as when COPY loads sorted
+ * data into a table that already has rows.  The leaf page that the previous
+ * tuple was inserted on is remembered in the statement-lifespan cache kept
+ * in insertstate->cache, and if the new tuple belongs on the same page, we
+ * insert it there directly.  Since the page is not known to be rightmost, we
+ * have to check that the scan key is strictly greater than the first
+ * non-pivot tuple and strictly less than the high key; the latter also
+ * guarantees that _bt_findinsertloc() won't have to move right, which would
+ * need a descent stack.  We stop trying once the cache has failed more often
+ * than it has succeeded, since insertions that arrive in random order would
+ * only pay for the extra page access.
  */
 static BTStack
 _bt_search_insert(Relation rel, Relation heaprel, BTInsertState insertstate)
 {
+	BTInsertCache cache = insertstate->cache;
+
 	Assert(insertstate->buf == InvalidBuffer);
 	Assert(!insertstate->bounds_valid);
 	Assert(insertstate->postingoff == 0);
@@ -376,6 +402,54 @@ _bt_search_insert(Relation rel, Relation heaprel, BTInsertState insertstate)
 		RelationSetTargetBlock(rel, InvalidBlockNumber);
 	}
 
+	if (cache != NULL && BlockNumberIsValid(cache->lastleaf) &&
+		(cache->nmisses < BTREE_LEAFCACHE_MIN_MISSES ||
+		 cache->nhits >= cache->nmisses))
+	{
+		insertstate->buf = ReadBuffer(rel, cache->lastleaf);
+		if (_bt_conditionallockbuf(rel, insertstate->buf))
+		{
+			Page		page;
+			BTPageOpaque opaque;
+
+			_bt_checkpage(rel, insertstate->buf);
+			page = BufferGetPage(insertstate->buf);
+			opaque = BTPageGetOpaque(page);
+
+			/*
+			 * Check that the page is still a leaf page that can fit caller's
+			 * new tuple without splitting, and that the new tuple belongs on
+			 * it (see above).  Don't bother with a root page; descending to
+			 * it is cheap anyway.  Unlike the rightmost leaf page, the cached
+			 * page might be the left half of an incomplete split, which only
+			 * a full descent knows how to finish.
+			 */
+			if (P_ISLEAF(opaque) &&
+				!P_ISROOT(opaque) &&
+				!P_IGNORE(opaque) &&
+				!P_INCOMPLETE_SPLIT(opaque) &&
+				PageGetFreeSpace(page) > insertstate->itemsz &&
+				PageGetMaxOffsetNumber(page) >= P_FIRSTDATAKEY(opaque) &&
+				_bt_compare(rel, insertstate->itup_key, page,
+							P_FIRSTDATAKEY(opaque)) > 0 &&
+				(P_RIGHTMOST(opaque) ||
+				 _bt_compare(rel, insertstate->itup_key, page, P_HIKEY) < 0))
+			{
+				cache->nhits++;
+				return NULL;
+			}
+
+			/* Page unsuitable for caller, drop lock and pin */
+			_bt_relbuf(rel, insertstate->buf);
+		}
+		else
+		{
+			/* Lock unavailable, drop pin */
+			ReleaseBuffer(insertstate->buf);
+		}
+		cache->nmisses++;
+	}
+
 	/* Cannot use optimization -- descend tree, return proper descent stack */
 	return _bt_search(rel, heaprel, insertstate->itup_key, &insertstate->buf,
 					  BT_WRITE);
@@ -207,12 +207,30 @@ btinsert(Relation rel, Datum *values, bool *isnull,
 {
 	bool		result;
 	IndexTuple	itup;
+	BTInsertCache cache = NULL;
+
+	/* set up the insertion cache, on the first call in this statement */
+	if (indexInfo != NULL)
+	{
+		cache = (BTInsertCache) indexInfo->ii_AmCache;
+		if (cache == NULL)
+		{
+			cache = (BTInsertCache)
+				MemoryContextAlloc(indexInfo->ii_Context,
+								   sizeof(BTInsertCacheData));
+			cache->lastleaf = InvalidBlockNumber;
+			cache->nhits = 0;
+			cache->nmisses = 0;
+			indexInfo->ii_AmCache = cache;
+		}
+	}
 
 	/* generate an index tuple */
 	itup = index_form_tuple(RelationGetDescr(rel), values, isnull);
 	itup->t_tid = *ht_ctid;
 
-	result = _bt_doinsert(rel, itup, checkUnique, indexUnchanged, heapRel);
+	result = _bt_doinsert(rel, itup, checkUnique, indexUnchanged, heapRel,
+						  cache);
 
 	pfree(itup);
 
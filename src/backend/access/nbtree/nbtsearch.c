@@ -30,6 +30,9 @@ static Buffer _bt_moveright(Relation rel, Relation heaprel, BTScanInsert key,
 							Buffer buf, bool forupdate, BTStack stack,
 							int access);
 static OffsetNumber _bt_binsrch(Relation rel, BTScanInsert key, Buffer buf);
+static inline int32 _bt_compare_prefix(Relation rel, BTScanInsert key,
+									   Page page, OffsetNumber offnum,
+									   int *nequal);
 static int	_bt_binsrch_posting(BTScanInsert key, Page page,
 								OffsetNumber offnum);
 static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir,
@@ -355,6 +358,8 @@ _bt_binsrch(Relation rel,
 				high;
 	int32		result,
 				cmpval;
+	int			lowequal = 0,
+				highequal = 0;
 
 	page = BufferGetPage(buf);
 	opaque = BTPageGetOpaque(page);
@@ -388,6 +393,14 @@ _bt_binsrch(Relation rel,
 	 * 'low' are <= scan key, all slots at or after 'high' are > scan key.
 	 *
 	 * We can fall out when high == low.
+	 *
+	 * We also keep track of how many leading key attributes of the tuples
+	 * just before 'low' and at 'high' were found to be equal to the scan key.
+	 * Since the page is sorted, every tuple in between has those attributes
+	 * equal to the scan key too, so _bt_compare_prefix() can skip them.  In
+	 * multicolumn indexes whose leading columns have few distinct values
+	 * (tenant_id + path, say), that avoids most of the calls to the
+	 * comparison functions of the leading columns.
 	 */
 	high++;						/* establish the loop invariant for high */
 
@@ -396,15 +409,22 @@ _bt_binsrch(Relation rel,
 	while (high > low)
 	{
 		OffsetNumber mid = low + ((high - low) / 2);
+		int			nequal = Min(lowequal, highequal);
 
 		/* We have low <= mid < high, so mid points at a real slot */
 
-		result = _bt_compare(rel, key, page, mid);
+		result = _bt_compare_prefix(rel, key, page, mid, &nequal);
 
 		if (result >= cmpval)
+		{
 			low = mid + 1;
+			lowequal = nequal;
+		}
 		else
+		{
 			high = mid;
+			highequal = nequal;
+		}
 	}
 
 	/*
@@ -694,6 +714,26 @@ _bt_compare(Relation rel,
 			BTScanInsert key,
 			Page page,
 			OffsetNumber offnum)
+{
+	int			nequal = 0;
+
+	return _bt_compare_prefix(rel, key, page, offnum, &nequal);
+}
+
+/*
+ *	_bt_compare_prefix() -- _bt_compare() with a known-equal key prefix.
+ *
+ * On entry, *nequal is the number of leading key attributes that caller
+ * knows to be equal to the scan key in the tuple at offnum, which are not
+ * compared again.  On exit, it is set to the number of leading key
+ * attributes that are equal to the scan key.
+ */
+static inline int32
+_bt_compare_prefix(Relation rel,
+				   BTScanInsert key,
+				   Page page,
+				   OffsetNumber offnum,
+				   int *nequal)
 {
 	TupleDesc	itupdesc = RelationGetDescr(rel);
 	BTPageOpaque opaque = BTPageGetOpaque(page);
@@ -702,6 +742,7 @@ _bt_compare(Relation rel,
 	ScanKey		scankey;
 	int			ncmpkey;
 	int			ntupatts;
+	int			skip;
 	int32		result;
 
 	Assert(_bt_check_natts(rel, key->heapkeyspace, page, offnum));
@@ -713,7 +754,10 @@ _bt_compare(Relation rel,
 	 * --- see NOTE above.
 	 */
 	if (!P_ISLEAF(opaque) && offnum == P_FIRSTDATAKEY(opaque))
+	{
+		*nequal = 0;
 		return 1;
+	}
 
 	itup = (IndexTuple) PageGetItem(page, PageGetItemId(page, offnum));
 	ntupatts = BTreeTupleGetNAtts(itup, rel);
@@ -733,8 +777,9 @@ _bt_compare(Relation rel,
 	ncmpkey = Min(ntupatts, key->keysz);
 	Assert(key->heapkeyspace || ncmpkey == key->keysz);
 	Assert(!BTreeTupleIsPosting(itup) || key->allequalimage);
-	scankey = key->scankeys;
-	for (int i = 1; i <= ncmpkey; i++)
+	skip = Min(*nequal, ncmpkey);
+	scankey = key->scankeys + skip;
+	for (int i = skip + 1; i <= ncmpkey; i++)
 	{
 		Datum		datum;
 		bool		isNull;
@@ -778,10 +823,14 @@ _bt_compare(Relation rel,
 
 		/* if the keys are unequal, return the difference */
 		if (result != 0)
+		{
+			*nequal = i - 1;
 			return result;
+		}
 
 		scankey++;
 	}
+	*nequal = ncmpkey;
 
 	/*
 	 * All non-truncated attributes (other than heap TID) were found to be
@@ -1095,6 +1095,7 @@ CREATE VIEW pg_stat_database AS
             pg_stat_get_db_session_time(D.oid) AS session_time,
             pg_stat_get_db_active_time(D.oid) AS active_time,
             pg_stat_get_db_idle_in_transaction_time(D.oid) AS idle_in_transaction_time,
+            pg_stat_get_db_session_setup_time(D.oid) AS session_setup_time,
             pg_stat_get_db_sessions(D.oid) AS sessions,
             pg_stat_get_db_sessions_abandoned(D.oid) AS sessions_abandoned,
             pg_stat_get_db_sessions_fatal(D.oid) AS sessions_fatal,
@@ -779,6 +779,15 @@ Async_UnlistenAll(void)
 	queue_listen(LISTEN_UNLISTEN_ALL, "");
 }
 
+/*
+ * Is this backend actively listening on any channel?
+ */
+bool
+IsListeningOnAnyChannel(void)
+{
+	return listenChannels != NIL;
+}
+
 /*
  * SQL function: return a set of the channel names this backend is actively
  * listening to.
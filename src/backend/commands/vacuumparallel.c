@@ -16,6 +16,12 @@
  * the parallel context is re-initialized so that the same DSM can be used for
  * multiple passes of index bulk-deletion and index cleanup.
  *
+ * The same workers can also share the second pass over the heap, which marks
+ * the LP_DEAD items collected in the dead items store as LP_UNUSED once the
+ * indexes no longer point to them.  The heap blocks are divided into chunks,
+ * and each participant vacuums the blocks in the chunks it claims; see
+ * parallel_vacuum_claim_heap_block().
+ *
  * Portions Copyright (c) 1996-2025, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
  *
@@ -28,6 +34,7 @@
 
 #include "access/amapi.h"
 #include "access/table.h"
+#include "access/tableam.h"
 #include "access/xact.h"
 #include "commands/progress.h"
 #include "commands/vacuum.h"
@@ -50,6 +57,15 @@
 #define PARALLEL_VACUUM_KEY_WAL_USAGE		4
 #define PARALLEL_VACUUM_KEY_INDEX_STATS		5
 
+/*
+ * Number of consecutive heap blocks handed out to one participant at a time
+ * during the second heap pass.
+ */
+#define PARALLEL_VACUUM_HEAP_CHUNK_SIZE		256
+
+/* Value of ParallelVacuumState.heap_chunk when no chunk has been claimed */
+#define InvalidHeapChunk					PG_UINT32_MAX
+
 /*
  * Shared information among parallel workers.  So this is allocated in the DSM
  * segment.
@@ -119,6 +135,21 @@ typedef struct PVShared
 
 	/* Statistics of shared dead items */
 	VacDeadItemsInfo dead_items_info;
+
+	/*
+	 * Fields for the second heap pass.  heap_pass is true while workers are
+	 * launched to vacuum the heap rather than indexes, and heap_oldest_xmin
+	 * is the cutoff used to decide whether a vacuumed page has become
+	 * all-visible.  heap_next_chunk is the first chunk of heap blocks that
+	 * nobody has claimed yet.  The remaining counters accumulate the work
+	 * done by the workers, for the leader to add to its own.
+	 */
+	bool		heap_pass;
+	TransactionId heap_oldest_xmin;
+	pg_atomic_uint32 heap_next_chunk;
+	pg_atomic_uint32 heap_vacuumed_pages;
+	pg_atomic_uint32 heap_new_visible_pages;
+	pg_atomic_uint32 heap_new_visible_frozen_pages;
 } PVShared;
 
 /* Status used during parallel index vacuum or cleanup */
@@ -219,6 +250,9 @@ struct ParallelVacuumState
 	char	   *relname;
 	char	   *indname;
 	PVIndVacStatus status;
+
+	/* Chunk of heap blocks this process owns during the second heap pass */
+	uint32		heap_chunk;
 };
 
 static int	parallel_vacuum_compute_workers(Relation *indrels, int nindexes, int nrequested,
@@ -390,6 +424,10 @@ parallel_vacuum_init(Relation rel, Relation *indrels, int nindexes,
 	pg_atomic_init_u32(&(shared->cost_balance), 0);
 	pg_atomic_init_u32(&(shared->active_nworkers), 0);
 	pg_atomic_init_u32(&(shared->idx), 0);
+	pg_atomic_init_u32(&(shared->heap_next_chunk), 0);
+	pg_atomic_init_u32(&(shared->heap_vacuumed_pages), 0);
+	pg_atomic_init_u32(&(shared->heap_new_visible_pages), 0);
+	pg_atomic_init_u32(&(shared->heap_new_visible_frozen_pages), 0);
 
 	shm_toc_insert(pcxt->toc, PARALLEL_VACUUM_KEY_SHARED, shared);
 	pvs->shared = shared;
@@ -532,6 +570,144 @@ parallel_vacuum_cleanup_all_indexes(ParallelVacuumState *pvs, long num_table_tup
 	parallel_vacuum_process_all_indexes(pvs, num_index_scans, false);
 }
 
+/*
+ * Launch parallel workers to share the second heap pass with the leader.
+ *
+ * npages is an estimate of the number of heap pages to vacuum, so that we
+ * don't launch workers that would have next to nothing to do: like for a
+ * parallel scan of the table, each worker should get at least
+ * min_parallel_table_scan_size worth of pages.  Returns the number of workers
+ * launched.  If that's zero, the leader performs the pass alone and must not
+ * call parallel_vacuum_heap_pass_end().
+ *
+ * The workers perform their share of the pass through the table AM's
+ * relation_vacuum_parallel_pass callback, which must be provided.
+ */
+int
+parallel_vacuum_heap_pass_begin(ParallelVacuumState *pvs,
+								TransactionId oldest_xmin, BlockNumber npages)
+{
+	int			nworkers;
+
+	Assert(!IsParallelWorker());
+	Assert(pvs->heaprel->rd_tableam->relation_vacuum_parallel_pass != NULL);
+
+	nworkers = Min(pvs->pcxt->nworkers,
+				   npages / Max(min_parallel_table_scan_size, 1));
+	if (nworkers <= 0)
+		return 0;
+
+	pvs->shared->heap_pass = true;
+	pvs->shared->heap_oldest_xmin = oldest_xmin;
+	pg_atomic_write_u32(&(pvs->shared->heap_next_chunk), 0);
+	pg_atomic_write_u32(&(pvs->shared->heap_vacuumed_pages), 0);
+	pg_atomic_write_u32(&(pvs->shared->heap_new_visible_pages), 0);
+	pg_atomic_write_u32(&(pvs->shared->heap_new_visible_frozen_pages), 0);
+	pvs->heap_chunk = InvalidHeapChunk;
+
+	/*
+	 * The second heap pass always follows an index bulk-deletion pass, so the
+	 * parallel context must be reinitialized before relaunching workers.
+	 */
+	ReinitializeParallelDSM(pvs->pcxt);
+
+	/* Setup the shared cost-based vacuum delay, as for index vacuuming */
+	pg_atomic_write_u32(&(pvs->shared->cost_balance), VacuumCostBalance);
+	pg_atomic_write_u32(&(pvs->shared->active_nworkers), 0);
+
+	ReinitializeParallelWorkers(pvs->pcxt, nworkers);
+	LaunchParallelWorkers(pvs->pcxt);
+
+	ereport(pvs->shared->elevel,
+			(errmsg(ngettext("launched %d parallel vacuum worker for heap vacuuming (planned: %d)",
+							 "launched %d parallel vacuum workers for heap vacuuming (planned: %d)",
+							 pvs->pcxt->nworkers_launched),
+					pvs->pcxt->nworkers_launched, nworkers)));
+
+	if (pvs->pcxt->nworkers_launched == 0)
+	{
+		pvs->shared->heap_pass = false;
+		return 0;
+	}
+
+	VacuumCostBalance = 0;
+	VacuumCostBalanceLocal = 0;
+	VacuumSharedCostBalance = &(pvs->shared->cost_balance);
+	VacuumActiveNWorkers = &(pvs->shared->active_nworkers);
+
+	/* The leader takes part in the pass */
+	pg_atomic_add_fetch_u32(VacuumActiveNWorkers, 1);
+
+	return pvs->pcxt->nworkers_launched;
+}
+
+/*
+ * Wait for the workers launched by parallel_vacuum_heap_pass_begin() to
+ * finish their part of the second heap pass, and return the number of pages
+ * they vacuumed and newly set all-visible (and all-frozen) in the VM.
+ */
+void
+parallel_vacuum_heap_pass_end(ParallelVacuumState *pvs,
+							  BlockNumber *vacuumed_pages,
+							  BlockNumber *new_visible_pages,
+							  BlockNumber *new_visible_frozen_pages)
+{
+	Assert(!IsParallelWorker());
+	Assert(pvs->shared->heap_pass);
+
+	pg_atomic_sub_fetch_u32(VacuumActiveNWorkers, 1);
+
+	WaitForParallelWorkersToFinish(pvs->pcxt);
+
+	for (int i = 0; i < pvs->pcxt->nworkers_launched; i++)
+		InstrAccumParallelQuery(&pvs->buffer_usage[i], &pvs->wal_usage[i]);
+
+	*vacuumed_pages = pg_atomic_read_u32(&(pvs->shared->heap_vacuumed_pages));
+	*new_visible_pages = pg_atomic_read_u32(&(pvs->shared->heap_new_visible_pages));
+	*new_visible_frozen_pages =
+		pg_atomic_read_u32(&(pvs->shared->heap_new_visible_frozen_pages));
+
+	pvs->shared->heap_pass = false;
+
+	/* Carry the shared balance value back and disable shared costing */
+	VacuumCostBalance = pg_atomic_read_u32(VacuumSharedCostBalance);
+	VacuumSharedCostBalance = NULL;
+	VacuumActiveNWorkers = NULL;
+}
+
+/*
+ * Should this process vacuum heap block blkno during the second heap pass?
+ *
+ * Every participant walks the whole dead items store in block order, and
+ * vacuums only the blocks in chunks it has claimed.  The shared counter holds
+ * the first chunk nobody has claimed yet, so a chunk below it belongs to some
+ * other participant.  When we claim a chunk above the counter, the chunks in
+ * between are skipped over too: we have already walked past them without
+ * finding them unclaimed, so they contain no blocks to vacuum.
+ */
+bool
+parallel_vacuum_claim_heap_block(ParallelVacuumState *pvs, BlockNumber blkno)
+{
+	uint32		chunk = blkno / PARALLEL_VACUUM_HEAP_CHUNK_SIZE;
+	uint32		next;
+
+	if (chunk == pvs->heap_chunk)
+		return true;
+
+	next = pg_atomic_read_u32(&(pvs->shared->heap_next_chunk));
+	while (next <= chunk)
+	{
+		if (pg_atomic_compare_exchange_u32(&(pvs->shared->heap_next_chunk),
+										   &next, chunk + 1))
+		{
+			pvs->heap_chunk = chunk;
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /*
  * Compute the number of parallel worker processes to request.  Both index
  * vacuum and index cleanup can be executed with parallel workers.
@@ -983,7 +1159,8 @@ parallel_vacuum_index_is_parallel_safe(Relation indrel, int num_index_scans,
  * Perform work within a launched parallel process.
  *
  * Since parallel vacuum workers perform only index vacuum or index cleanup,
- * we don't need to report progress information.
+ * or their share of the second heap pass, we don't need to report progress
+ * information.
  */
 void
 parallel_vacuum_main(dsm_segment *seg, shm_toc *toc)
@@ -1071,6 +1248,7 @@ parallel_vacuum_main(dsm_segment *seg, shm_toc *toc)
 	/* These fields will be filled during index vacuum or cleanup */
 	pvs.indname = NULL;
 	pvs.status = PARALLEL_INDVAC_STATUS_INITIAL;
+	pvs.heap_chunk = InvalidHeapChunk;
 
 	/* Each parallel VACUUM worker gets its own access strategy. */
 	pvs.bstrategy = GetAccessStrategyWithSize(BAS_VACUUM,
@@ -1085,8 +1263,34 @@ parallel_vacuum_main(dsm_segment *seg, shm_toc *toc)
 	/* Prepare to track buffer usage during parallel execution */
 	InstrStartParallelQuery();
 
-	/* Process indexes to perform vacuum/cleanup */
-	parallel_vacuum_process_safe_indexes(&pvs);
+	if (shared->heap_pass)
+	{
+		BlockNumber vacuumed_pages;
+		BlockNumber new_visible_pages;
+		BlockNumber new_visible_frozen_pages;
+
+		/* Take part in the second heap pass */
+		pg_atomic_add_fetch_u32(VacuumActiveNWorkers, 1);
+		table_relation_vacuum_parallel_pass(rel, &pvs, dead_items,
+											shared->heap_oldest_xmin,
+											pvs.bstrategy,
+											&vacuumed_pages,
+											&new_visible_pages,
+											&new_visible_frozen_pages);
+		pg_atomic_sub_fetch_u32(VacuumActiveNWorkers, 1);
+
+		pg_atomic_add_fetch_u32(&(shared->heap_vacuumed_pages),
+								vacuumed_pages);
+		pg_atomic_add_fetch_u32(&(shared->heap_new_visible_pages),
+								new_visible_pages);
+		pg_atomic_add_fetch_u32(&(shared->heap_new_visible_frozen_pages),
+								new_visible_frozen_pages);
+	}
+	else
+	{
+		/* Process indexes to perform vacuum/cleanup */
+		parallel_vacuum_process_safe_indexes(&pvs);
+	}
 
 	/* Report buffer/WAL usage during parallel execution */
 	buffer_usage = shm_toc_lookup(toc, PARALLEL_VACUUM_KEY_BUFFER_USAGE, false);
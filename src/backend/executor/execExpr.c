@@ -901,6 +901,12 @@ ExecCheck(ExprState *state, ExprContext *econtext)
 static void
 ExecReadyExpr(ExprState *state)
 {
+	if (jit_defer_compile_expr(state))
+	{
+		ExecReadyInterpretedExprDeferJit(state, jit_expression_threshold);
+		return;
+	}
+
 	if (jit_compile_expr(state))
 		return;
 
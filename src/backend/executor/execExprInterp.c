@@ -62,6 +62,7 @@
 #include "executor/execExpr.h"
 #include "executor/nodeSubplan.h"
 #include "funcapi.h"
+#include "jit/jit.h"
 #include "miscadmin.h"
 #include "nodes/miscnodes.h"
 #include "nodes/nodeFuncs.h"
@@ -76,6 +77,7 @@
 #include "utils/jsonpath.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
+#include "utils/resowner.h"
 #include "utils/timestamp.h"
 #include "utils/typcache.h"
 #include "utils/xml.h"
@@ -142,6 +144,7 @@ static ExprEvalOpLookup reverse_dispatch_table[EEOP_LAST];
 
 
 static Datum ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull);
+static Datum ExecInterpExprTierUp(ExprState *state, ExprContext *econtext, bool *isnull);
 static void ExecInitInterpreter(void);
 
 /* support functions */
@@ -446,6 +449,68 @@ ExecReadyInterpretedExpr(ExprState *state)
 	state->evalfunc_private = ExecInterpExpr;
 }
 
+/*
+ * Prepare ExprState for interpreted execution, to be JIT compiled once it has
+ * been evaluated the given number of times.
+ *
+ * Expressions that use one of the fast-path evalfuncs are cheap enough to
+ * evaluate already, so they're never compiled.
+ */
+void
+ExecReadyInterpretedExprDeferJit(ExprState *state, int evals)
+{
+	Assert(evals > 0);
+
+	ExecReadyInterpretedExpr(state);
+
+	if (state->evalfunc_private == ExecInterpExpr)
+	{
+		state->jit_countdown = evals;
+		state->evalfunc_private = ExecInterpExprTierUp;
+	}
+}
+
+/*
+ * Evaluate an expression with the interpreter, until it has been evaluated
+ * often enough to be worth JIT compiling; see
+ * ExecReadyInterpretedExprDeferJit().
+ */
+static Datum
+ExecInterpExprTierUp(ExprState *state, ExprContext *econtext, bool *isnull)
+{
+	if (--state->jit_countdown <= 0)
+	{
+		EState	   *estate = state->parent->state;
+		MemoryContext oldcontext;
+		ResourceOwner oldowner;
+		bool		compiled;
+
+		/* from now on, evaluate directly, unless compilation succeeds */
+		state->evalfunc = ExecInterpExpr;
+
+		/*
+		 * We're typically called in a per-tuple memory context, but the
+		 * compiled expression's state has to survive until executor
+		 * shutdown.  Likewise, the JIT context may be created here, and it
+		 * must not be released at the end of a subtransaction that happens
+		 * to be running the query now, so create it under the owner that was
+		 * current at executor startup.
+		 */
+		oldcontext = MemoryContextSwitchTo(estate->es_query_cxt);
+		oldowner = CurrentResourceOwner;
+		if (estate->es_jit_owner)
+			CurrentResourceOwner = estate->es_jit_owner;
+		compiled = jit_compile_expr(state);
+		CurrentResourceOwner = oldowner;
+		MemoryContextSwitchTo(oldcontext);
+
+		if (compiled)
+			return state->evalfunc(state, econtext, isnull);
+	}
+
+	return ExecInterpExpr(state, econtext, isnull);
+}
+
 
 /*
  * Evaluate expression identified by "state" in the execution context
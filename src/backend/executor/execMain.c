@@ -247,6 +247,7 @@ standard_ExecutorStart(QueryDesc *queryDesc, int eflags)
 	estate->es_top_eflags = eflags;
 	estate->es_instrument = queryDesc->instrument_options;
 	estate->es_jit_flags = queryDesc->plannedstmt->jitFlags;
+	estate->es_jit_owner = CurrentResourceOwner;
 
 	/*
 	 * Set up an AFTER-trigger statement context, unless told not to, or
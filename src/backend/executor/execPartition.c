@@ -184,6 +184,8 @@ static List *adjust_partition_colnos_using_map(List *colnos, AttrMap *attrMap);
 static PartitionPruneState *CreatePartitionPruneState(EState *estate,
 													  PartitionPruneInfo *pruneinfo,
 													  Bitmapset **all_leafpart_rtis);
+static bool PartitionDescMatchesPruneInfo(PartitionDesc partdesc,
+										  PartitionedRelPruneInfo *pinfo);
 static void InitPartitionPruneContext(PartitionPruneContext *context,
 									  List *pruning_steps,
 									  PartitionDesc partdesc,
@@ -2061,7 +2063,10 @@ CreatePartitionPruneState(EState *estate, PartitionPruneInfo *pruneinfo,
 			 * existed when the plan was made.  The normal case is that it is;
 			 * optimize for that case with a quick comparison, and just copy
 			 * the subplan_map and make subpart_map, leafpart_rti_map point to
-			 * the ones in PruneInfo.
+			 * the ones in PruneInfo.  Note that the quick comparison has to
+			 * cope with partitions that the planner pruned, which have no
+			 * entry in relid_map; otherwise, with many partitions, we'd
+			 * nearly always end up in the much slower general case.
 			 *
 			 * For the case where they aren't identical, we could have more
 			 * partitions on either side; or even exactly the same number of
@@ -2075,9 +2080,7 @@ CreatePartitionPruneState(EState *estate, PartitionPruneInfo *pruneinfo,
 			pprune->nparts = partdesc->nparts;
 			pprune->subplan_map = palloc(sizeof(int) * partdesc->nparts);
 
-			if (partdesc->nparts == pinfo->nparts &&
-				memcmp(partdesc->oids, pinfo->relid_map,
-					   sizeof(int) * partdesc->nparts) == 0)
+			if (PartitionDescMatchesPruneInfo(partdesc, pinfo))
 			{
 				pprune->subpart_map = pinfo->subpart_map;
 				pprune->leafpart_rti_map = pinfo->leafpart_rti_map;
@@ -2227,6 +2230,34 @@ CreatePartitionPruneState(EState *estate, PartitionPruneInfo *pruneinfo,
 	return prunestate;
 }
 
+/*
+ * PartitionDescMatchesPruneInfo
+ *		Does the partition descriptor contain the same partitions, in the
+ *		same order, as the one the planner saw when making pinfo?
+ *
+ * Partitions that the planner pruned have no entry in pinfo->relid_map, so
+ * we can only compare the others.  If a partition was concurrently detached
+ * and another one attached in its place, and the planner pruned the detached
+ * one, we'll treat the new one as pruned too, which is just what the general
+ * matching code in CreatePartitionPruneState() would do.
+ */
+static bool
+PartitionDescMatchesPruneInfo(PartitionDesc partdesc,
+							  PartitionedRelPruneInfo *pinfo)
+{
+	if (partdesc->nparts != pinfo->nparts)
+		return false;
+
+	for (int i = 0; i < partdesc->nparts; i++)
+	{
+		if (OidIsValid(pinfo->relid_map[i]) &&
+			pinfo->relid_map[i] != partdesc->oids[i])
+			return false;
+	}
+
+	return true;
+}
+
 /*
  * Initialize a PartitionPruneContext for the given list of pruning steps.
  */
@@ -39,6 +39,7 @@ bool		jit_tuple_deforming = true;
 double		jit_above_cost = 100000;
 double		jit_inline_above_cost = 500000;
 double		jit_optimize_above_cost = 500000;
+int			jit_expression_threshold = 0;
 
 static JitProviderCallbacks provider;
 static bool provider_successfully_loaded = false;
@@ -46,6 +47,7 @@ static bool provider_failed_loading = false;
 
 
 static bool provider_init(void);
+static bool jit_expr_wanted(struct ExprState *state);
 
 
 /*
@@ -149,6 +151,46 @@ jit_release_context(JitContext *context)
  */
 bool
 jit_compile_expr(struct ExprState *state)
+{
+	if (!jit_expr_wanted(state))
+		return false;
+
+	/* this also takes !jit_enabled into account */
+	if (provider_init())
+		return provider.compile_expr(state);
+
+	return false;
+}
+
+/*
+ * Should compilation of the expression be deferred until it has been
+ * evaluated jit_expression_threshold times?
+ *
+ * If so, the caller is expected to set up the expression for interpreted
+ * execution, and to call jit_compile_expr() once the expression has been
+ * evaluated often enough.  That way expressions that turn out to be evaluated
+ * only a few times, despite the planner's estimates, don't pay for
+ * compilation.
+ */
+bool
+jit_defer_compile_expr(struct ExprState *state)
+{
+	if (jit_expression_threshold <= 0)
+		return false;
+
+	if (!jit_expr_wanted(state))
+		return false;
+
+	/* this also takes !jit_enabled into account */
+	return provider_init();
+}
+
+/*
+ * Check whether the query that the expression belongs to wants expressions to
+ * be JIT compiled.
+ */
+static bool
+jit_expr_wanted(struct ExprState *state)
 {
 	/*
 	 * We can easily create a one-off context for functions without an
@@ -170,11 +212,7 @@ jit_compile_expr(struct ExprState *state)
 	if (!(state->parent->state->es_jit_flags & PGJIT_EXPR))
 		return false;
 
-	/* this also takes !jit_enabled into account */
-	if (provider_init())
-		return provider.compile_expr(state);
-
-	return false;
+	return true;
 }
 
 /* Aggregate JIT instrumentation information */
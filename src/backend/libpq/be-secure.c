@@ -303,10 +303,32 @@ secure_raw_read(Port *port, void *ptr, size_t len)
  */
 ssize_t
 secure_write(Port *port, const void *ptr, size_t len)
+{
+	struct iovec iov;
+
+	iov.iov_base = unconstify(void *, ptr);
+	iov.iov_len = len;
+
+	return secure_writev(port, &iov, 1);
+}
+
+/*
+ *	Write a vector of buffers to a secure connection.
+ *
+ * Like secure_write(), this may write less than the total length of the
+ * buffers; the caller must be prepared to retry with the remainder.  Only
+ * unencrypted connections can send more than one buffer per call, since
+ * the SSL and GSSAPI layers have no vectored write interface; for those we
+ * just send (part of) the first buffer.
+ */
+ssize_t
+secure_writev(Port *port, const struct iovec *iov, int iovcnt)
 {
 	ssize_t		n;
 	int			waitfor;
 
+	Assert(iovcnt > 0);
+
 	/* Deal with any already-pending interrupt condition. */
 	ProcessClientWriteInterrupt(false);
 
@@ -315,20 +337,20 @@ retry:
 #ifdef USE_SSL
 	if (port->ssl_in_use)
 	{
-		n = be_tls_write(port, ptr, len, &waitfor);
+		n = be_tls_write(port, iov[0].iov_base, iov[0].iov_len, &waitfor);
 	}
 	else
 #endif
 #ifdef ENABLE_GSS
 	if (port->gss && port->gss->enc)
 	{
-		n = be_gssapi_write(port, ptr, len);
+		n = be_gssapi_write(port, iov[0].iov_base, iov[0].iov_len);
 		waitfor = WL_SOCKET_WRITEABLE;
 	}
 	else
 #endif
 	{
-		n = secure_raw_write(port, ptr, len);
+		n = secure_raw_writev(port, iov, iovcnt);
 		waitfor = WL_SOCKET_WRITEABLE;
 	}
 
@@ -388,3 +410,25 @@ secure_raw_write(Port *port, const void *ptr, size_t len)
 
 	return n;
 }
+
+ssize_t
+secure_raw_writev(Port *port, const struct iovec *iov, int iovcnt)
+{
+#ifndef WIN32
+	struct msghdr msg;
+
+	/* Avoid the overhead of sendmsg() for the common single-buffer case. */
+	if (iovcnt == 1)
+		return secure_raw_write(port, iov[0].iov_base, iov[0].iov_len);
+
+	Assert(iovcnt <= PG_IOV_MAX);
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = unconstify(struct iovec *, iov);
+	msg.msg_iovlen = iovcnt;
+
+	return sendmsg(port->sock, &msg, 0);
+#else
+	/* Our socket emulation has no sendmsg(); send just the first buffer. */
+	return secure_raw_write(port, iov[0].iov_base, iov[0].iov_len);
+#endif
+}
@@ -48,6 +48,7 @@
  * message-level I/O
  *		pq_putmessage	- send a normal message (suppressed in COPY OUT mode)
  *		pq_putmessage_noblock - buffer a normal message (suppressed in COPY OUT)
+ *		pq_putmessagev	- send a normal message assembled from several buffers
  *
  *------------------------
  */
@@ -134,6 +135,9 @@ static int	PqRecvLength;		/* End of data available in PqRecvBuffer */
 static bool PqCommBusy;			/* busy sending data to the client */
 static bool PqCommReadingMsg;	/* in the middle of reading a message */
 
+/* errno of the last send failure we reported, to suppress duplicates */
+static int	PqLastReportedSendErrno = 0;
+
 
 /* Internal functions */
 static void socket_comm_reset(void);
@@ -144,10 +148,13 @@ static int	socket_flush_if_writable(void);
 static bool socket_is_send_pending(void);
 static int	socket_putmessage(char msgtype, const char *s, size_t len);
 static void socket_putmessage_noblock(char msgtype, const char *s, size_t len);
+static int	socket_putmessagev(char msgtype, const struct iovec *iov, int iovcnt);
 static inline int internal_putbytes(const void *b, size_t len);
 static inline int internal_flush(void);
 static pg_noinline int internal_flush_buffer(const char *buf, size_t *start,
 											 size_t *end);
+static pg_noinline int internal_flush_vectored(const char *s, size_t len);
+static int	internal_send_failed(void);
 
 static int	Lock_AF_UNIX(const char *unixSocketDir, const char *unixSocketPath);
 static int	Setup_AF_UNIX(const char *sock_path);
@@ -158,7 +165,8 @@ static const PQcommMethods PqCommSocketMethods = {
 	.flush_if_writable = socket_flush_if_writable,
 	.is_send_pending = socket_is_send_pending,
 	.putmessage = socket_putmessage,
-	.putmessage_noblock = socket_putmessage_noblock
+	.putmessage_noblock = socket_putmessage_noblock,
+	.putmessagev = socket_putmessagev
 };
 
 const PQcommMethods *PqCommMethods = &PqCommSocketMethods;
@@ -1289,17 +1297,14 @@ internal_putbytes(const void *b, size_t len)
 		}
 
 		/*
-		 * If the buffer is empty and data length is larger than the buffer
-		 * size, send it without buffering.  Otherwise, copy as much data as
-		 * possible into the buffer.
+		 * If the data length is larger than the buffer size, send it without
+		 * buffering, together with anything already pending in the buffer.
+		 * Otherwise, copy as much data as possible into the buffer.
 		 */
-		if (len >= PqSendBufferSize && PqSendStart == PqSendPointer)
+		if (len >= PqSendBufferSize)
 		{
-			size_t		start = 0;
-
 			socket_set_nonblocking(false);
-			if (internal_flush_buffer(s, &start, &len))
-				return EOF;
+			return internal_flush_vectored(s, len);
 		}
 		else
 		{
@@ -1361,8 +1366,6 @@ internal_flush(void)
 static pg_noinline int
 internal_flush_buffer(const char *buf, size_t *start, size_t *end)
 {
-	static int	last_reported_send_errno = 0;
-
 	const char *bufptr = buf + *start;
 	const char *bufend = buf + *end;
 
@@ -1387,36 +1390,15 @@ internal_flush_buffer(const char *buf, size_t *start, size_t *end)
 				return 0;
 			}
 
-			/*
-			 * Careful: an ereport() that tries to write to the client would
-			 * cause recursion to here, leading to stack overflow and core
-			 * dump!  This message must go *only* to the postmaster log.
-			 *
-			 * If a client disconnects while we're in the midst of output, we
-			 * might write quite a bit of data before we get to a safe query
-			 * abort point.  So, suppress duplicate log messages.
-			 */
-			if (errno != last_reported_send_errno)
-			{
-				last_reported_send_errno = errno;
-				ereport(COMMERROR,
-						(errcode_for_socket_access(),
-						 errmsg("could not send data to client: %m")));
-			}
-
 			/*
 			 * We drop the buffered data anyway so that processing can
-			 * continue, even though we'll probably quit soon. We also set a
-			 * flag that'll cause the next CHECK_FOR_INTERRUPTS to terminate
-			 * the connection.
+			 * continue, even though we'll probably quit soon.
 			 */
 			*start = *end = 0;
-			ClientConnectionLost = 1;
-			InterruptPending = 1;
-			return EOF;
+			return internal_send_failed();
 		}
 
-		last_reported_send_errno = 0;	/* reset after any successful send */
+		PqLastReportedSendErrno = 0;	/* reset after any successful send */
 		bufptr += r;
 		*start += r;
 	}
@@ -1425,6 +1407,105 @@ internal_flush_buffer(const char *buf, size_t *start, size_t *end)
 	return 0;
 }
 
+/* --------------------------------
+ *		internal_flush_vectored - flush pending output followed by more data
+ *
+ * Sends whatever is pending in PqSendBuffer and then the len bytes at s, using
+ * vectored writes so that a large payload doesn't have to be copied into
+ * PqSendBuffer first, nor cost a separate system call from the data buffered
+ * ahead of it.  The socket must be in blocking mode.
+ *
+ * Returns 0 if OK, or EOF if trouble.
+ * --------------------------------
+ */
+static pg_noinline int
+internal_flush_vectored(const char *s, size_t len)
+{
+	Assert(!MyProcPort->noblock);
+
+	while (PqSendStart < PqSendPointer || len > 0)
+	{
+		struct iovec iov[2];
+		int			iovcnt = 0;
+		size_t		pending = PqSendPointer - PqSendStart;
+		ssize_t		r;
+
+		if (pending > 0)
+		{
+			iov[iovcnt].iov_base = PqSendBuffer + PqSendStart;
+			iov[iovcnt].iov_len = pending;
+			iovcnt++;
+		}
+		if (len > 0)
+		{
+			iov[iovcnt].iov_base = unconstify(char *, s);
+			iov[iovcnt].iov_len = len;
+			iovcnt++;
+		}
+
+		r = secure_writev(MyProcPort, iov, iovcnt);
+
+		if (r <= 0)
+		{
+			if (errno == EINTR)
+				continue;		/* Ok if we were interrupted */
+
+			PqSendStart = PqSendPointer = 0;
+			return internal_send_failed();
+		}
+
+		PqLastReportedSendErrno = 0;	/* reset after any successful send */
+
+		/* Consume the buffered data first, then the caller's */
+		if ((size_t) r < pending)
+			PqSendStart += r;
+		else
+		{
+			PqSendStart = PqSendPointer = 0;
+			r -= pending;
+			s += r;
+			len -= r;
+		}
+	}
+
+	return 0;
+}
+
+/* --------------------------------
+ *		internal_send_failed - report a failure to send data to the client
+ *
+ * Always returns EOF, for the convenience of callers.
+ * --------------------------------
+ */
+static int
+internal_send_failed(void)
+{
+	/*
+	 * Careful: an ereport() that tries to write to the client would cause
+	 * recursion to here, leading to stack overflow and core dump!  This
+	 * message must go *only* to the postmaster log.
+	 *
+	 * If a client disconnects while we're in the midst of output, we might
+	 * write quite a bit of data before we get to a safe query abort point.
+	 * So, suppress duplicate log messages.
+	 */
+	if (errno != PqLastReportedSendErrno)
+	{
+		PqLastReportedSendErrno = errno;
+		ereport(COMMERROR,
+				(errcode_for_socket_access(),
+				 errmsg("could not send data to client: %m")));
+	}
+
+	/*
+	 * Set a flag that'll cause the next CHECK_FOR_INTERRUPTS to terminate the
+	 * connection.
+	 */
+	ClientConnectionLost = 1;
+	InterruptPending = 1;
+	return EOF;
+}
+
 /* --------------------------------
  *		pq_flush_if_writable - flush pending output if writable without blocking
  *
@@ -1541,6 +1622,52 @@ socket_putmessage_noblock(char msgtype, const char *s, size_t len)
 								 * buffer */
 }
 
+/* --------------------------------
+ *		socket_putmessagev - send a message whose body is given as a vector
+ *
+ *		This is like socket_putmessage, but lets the caller assemble the body
+ *		from several buffers without first copying them together.  Buffers
+ *		too large for PqSendBuffer are sent straight from the caller's memory,
+ *		which therefore only has to stay valid until we return.
+ *
+ *		returns 0 if OK, EOF if trouble
+ * --------------------------------
+ */
+static int
+socket_putmessagev(char msgtype, const struct iovec *iov, int iovcnt)
+{
+	uint32		n32;
+	size_t		len = 0;
+
+	Assert(msgtype != 0);
+
+	if (PqCommBusy)
+		return 0;
+	PqCommBusy = true;
+
+	for (int i = 0; i < iovcnt; i++)
+		len += iov[i].iov_len;
+
+	if (internal_putbytes(&msgtype, 1))
+		goto fail;
+
+	n32 = pg_hton32((uint32) (len + 4));
+	if (internal_putbytes(&n32, 4))
+		goto fail;
+
+	for (int i = 0; i < iovcnt; i++)
+	{
+		if (internal_putbytes(iov[i].iov_base, iov[i].iov_len))
+			goto fail;
+	}
+	PqCommBusy = false;
+	return 0;
+
+fail:
+	PqCommBusy = false;
+	return EOF;
+}
+
 /* --------------------------------
  *		pq_putmessage_v2 - send a message in protocol version 2
  *
@@ -35,6 +35,8 @@ static int	mq_flush_if_writable(void);
 static bool mq_is_send_pending(void);
 static int	mq_putmessage(char msgtype, const char *s, size_t len);
 static void mq_putmessage_noblock(char msgtype, const char *s, size_t len);
+static int	mq_putmessagev(char msgtype, const struct iovec *iov, int iovcnt);
+static int	mq_sendv(shm_mq_iovec *iov, int iovcnt);
 
 static const PQcommMethods PqCommMqMethods = {
 	.comm_reset = mq_comm_reset,
@@ -42,7 +44,8 @@ static const PQcommMethods PqCommMqMethods = {
 	.flush_if_writable = mq_flush_if_writable,
 	.is_send_pending = mq_is_send_pending,
 	.putmessage = mq_putmessage,
-	.putmessage_noblock = mq_putmessage_noblock
+	.putmessage_noblock = mq_putmessage_noblock,
+	.putmessagev = mq_putmessagev
 };
 
 /*
@@ -122,6 +125,43 @@ static int
 mq_putmessage(char msgtype, const char *s, size_t len)
 {
 	shm_mq_iovec iov[2];
+
+	iov[0].data = &msgtype;
+	iov[0].len = 1;
+	iov[1].data = s;
+	iov[1].len = len;
+
+	return mq_sendv(iov, 2);
+}
+
+/*
+ * Like mq_putmessage, but the message body is given as a vector of buffers.
+ */
+static int
+mq_putmessagev(char msgtype, const struct iovec *iov, int iovcnt)
+{
+	shm_mq_iovec mqiov[PG_IOV_MAX + 1];
+
+	Assert(iovcnt <= PG_IOV_MAX);
+
+	mqiov[0].data = &msgtype;
+	mqiov[0].len = 1;
+	for (int i = 0; i < iovcnt; i++)
+	{
+		mqiov[i + 1].data = iov[i].iov_base;
+		mqiov[i + 1].len = iov[i].iov_len;
+	}
+
+	return mq_sendv(mqiov, iovcnt + 1);
+}
+
+/*
+ * Workhorse for mq_putmessage and mq_putmessagev: send the given vector of
+ * buffers as a single shm_mq message.
+ */
+static int
+mq_sendv(shm_mq_iovec *iov, int iovcnt)
+{
 	shm_mq_result result;
 
 	/*
@@ -154,11 +194,6 @@ mq_putmessage(char msgtype, const char *s, size_t len)
 
 	pq_mq_busy = true;
 
-	iov[0].data = &msgtype;
-	iov[0].len = 1;
-	iov[1].data = s;
-	iov[1].len = len;
-
 	for (;;)
 	{
 		/*
@@ -167,7 +202,7 @@ mq_putmessage(char msgtype, const char *s, size_t len)
 		 * message signal right after this.
 		 */
 		Assert(pq_mq_handle != NULL);
-		result = shm_mq_sendv(pq_mq_handle, iov, 2, true, true);
+		result = shm_mq_sendv(pq_mq_handle, iov, iovcnt, true, true);
 
 		if (pq_mq_parallel_leader_pid != 0)
 		{
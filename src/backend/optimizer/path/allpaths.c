@@ -46,6 +46,7 @@
 #include "partitioning/partbounds.h"
 #include "port/pg_bitutils.h"
 #include "rewrite/rewriteManip.h"
+#include "utils/guc_hooks.h"
 #include "utils/lsyscache.h"
 
 
@@ -78,6 +79,7 @@ typedef enum pushdown_safe_type
 /* These parameters are set by GUC */
 bool		enable_geqo = false;	/* just in case GUC doesn't set it */
 int			geqo_threshold;
+int			join_search_dp_limit = 0;
 int			min_parallel_table_scan_size;
 int			min_parallel_index_scan_size;
 
@@ -88,6 +90,9 @@ set_rel_pathlist_hook_type set_rel_pathlist_hook = NULL;
 join_search_hook_type join_search_hook = NULL;
 
 
+static RelOptInfo *idp_join_search(PlannerInfo *root, int levels_needed,
+									List *initial_rels);
+static void join_search_level(PlannerInfo *root, int lev);
 static void set_base_rel_consider_startup(PlannerInfo *root);
 static void set_base_rel_sizes(PlannerInfo *root);
 static void set_base_rel_pathlists(PlannerInfo *root);
@@ -3402,7 +3407,8 @@ make_rel_from_joinlist(PlannerInfo *root, List *joinlist)
 	{
 		/*
 		 * Consider the different orders in which we could join the rels,
-		 * using a plugin, GEQO, or the regular join search code.
+		 * using a plugin, iterative dynamic programming, GEQO, or the regular
+		 * join search code.
 		 *
 		 * We put the initial_rels list into a PlannerInfo field because
 		 * has_legal_joinclause() needs to look at it (ugly :-().
@@ -3411,6 +3417,9 @@ make_rel_from_joinlist(PlannerInfo *root, List *joinlist)
 
 		if (join_search_hook)
 			return (*join_search_hook) (root, levels_needed, initial_rels);
+		else if (join_search_dp_limit > 0 &&
+				 levels_needed > join_search_dp_limit)
+			return idp_join_search(root, levels_needed, initial_rels);
 		else if (enable_geqo && levels_needed >= geqo_threshold)
 			return geqo(root, levels_needed, initial_rels);
 		else
@@ -3475,63 +3484,212 @@ standard_join_search(PlannerInfo *root, int levels_needed, List *initial_rels)
 	root->join_rel_level[1] = initial_rels;
 
 	for (lev = 2; lev <= levels_needed; lev++)
+		join_search_level(root, lev);
+
+	/*
+	 * We should have a single rel at the final level.
+	 */
+	if (root->join_rel_level[levels_needed] == NIL)
+		elog(ERROR, "failed to build any %d-way joins", levels_needed);
+	Assert(list_length(root->join_rel_level[levels_needed]) == 1);
+
+	rel = (RelOptInfo *) linitial(root->join_rel_level[levels_needed]);
+
+	root->join_rel_level = NULL;
+
+	return rel;
+}
+
+/*
+ * join_search_level
+ *	  Build all the join rels of one level of the dynamic programming search,
+ *	  and finish creating their paths.
+ */
+static void
+join_search_level(PlannerInfo *root, int lev)
+{
+	ListCell   *lc;
+
+	/*
+	 * Determine all possible pairs of relations to be joined at this level,
+	 * and build paths for making each one from every available pair of
+	 * lower-level relations.
+	 */
+	join_search_one_level(root, lev);
+
+	/*
+	 * Run generate_partitionwise_join_paths() and
+	 * generate_useful_gather_paths() for each just-processed joinrel.  We
+	 * could not do this earlier because both regular and partial paths can
+	 * get added to a particular joinrel at multiple times within
+	 * join_search_one_level.
+	 *
+	 * After that, we're done creating paths for the joinrel, so run
+	 * set_cheapest().
+	 */
+	foreach(lc, root->join_rel_level[lev])
 	{
-		ListCell   *lc;
+		RelOptInfo *rel = (RelOptInfo *) lfirst(lc);
 
-		/*
-		 * Determine all possible pairs of relations to be joined at this
-		 * level, and build paths for making each one from every available
-		 * pair of lower-level relations.
-		 */
-		join_search_one_level(root, lev);
+		/* Create paths for partitionwise joins. */
+		generate_partitionwise_join_paths(root, rel);
 
 		/*
-		 * Run generate_partitionwise_join_paths() and
-		 * generate_useful_gather_paths() for each just-processed joinrel.  We
-		 * could not do this earlier because both regular and partial paths
-		 * can get added to a particular joinrel at multiple times within
-		 * join_search_one_level.
-		 *
-		 * After that, we're done creating paths for the joinrel, so run
-		 * set_cheapest().
+		 * Except for the topmost scan/join rel, consider gathering partial
+		 * paths.  We'll do the same for the topmost scan/join rel once we
+		 * know the final targetlist (see grouping_planner's and its call to
+		 * apply_scanjoin_target_to_paths).
 		 */
-		foreach(lc, root->join_rel_level[lev])
-		{
-			rel = (RelOptInfo *) lfirst(lc);
-
-			/* Create paths for partitionwise joins. */
-			generate_partitionwise_join_paths(root, rel);
-
-			/*
-			 * Except for the topmost scan/join rel, consider gathering
-			 * partial paths.  We'll do the same for the topmost scan/join rel
-			 * once we know the final targetlist (see grouping_planner's and
-			 * its call to apply_scanjoin_target_to_paths).
-			 */
-			if (!bms_equal(rel->relids, root->all_query_rels))
-				generate_useful_gather_paths(root, rel, false);
+		if (!bms_equal(rel->relids, root->all_query_rels))
+			generate_useful_gather_paths(root, rel, false);
 
-			/* Find and save the cheapest paths for this rel */
-			set_cheapest(rel);
+		/* Find and save the cheapest paths for this rel */
+		set_cheapest(rel);
 
 #ifdef OPTIMIZER_DEBUG
-			pprint(rel);
+		pprint(rel);
 #endif
-		}
 	}
+}
 
-	/*
-	 * We should have a single rel at the final level.
-	 */
-	if (root->join_rel_level[levels_needed] == NIL)
-		elog(ERROR, "failed to build any %d-way joins", levels_needed);
-	Assert(list_length(root->join_rel_level[levels_needed]) == 1);
+/*
+ * idp_join_search
+ *	  Find a join order for many jointree items by iterative dynamic
+ *	  programming.
+ *
+ * The exhaustive search of standard_join_search() takes time that grows
+ * exponentially with the number of items.  Here, we run the same search on
+ * at most join_search_dp_limit items at a time: out of the largest join rels
+ * built, we keep the cheapest one, replace the items it was built from with
+ * it, forget all the other join rels, and start over, until there are few
+ * enough items left to join them all.  This is the "IDP1-standard-bestPlan"
+ * variant described by Kossmann and Stocker.  Unlike GEQO, it's
+ * deterministic, and it considers all join orders when the number of items
+ * is within the limit.
+ *
+ * The join rels we forget are not freed, since the chosen rel's paths may
+ * still point to some of them; unlike GEQO, we don't plan in a temporary
+ * memory context.  So this bounds the planning time, but memory use still
+ * grows with the number of rounds and the work done in each.
+ *
+ * Committing to a join rel early could in principle leave us with items that
+ * can't all be joined.  Rather than failing the query, we then forget
+ * everything we did and fall back to the search we'd have used otherwise.
+ */
+static RelOptInfo *
+idp_join_search(PlannerInfo *root, int levels_needed, List *initial_rels)
+{
+	int			block_size = join_search_dp_limit;
+	int			orig_levels_needed = levels_needed;
+	List	   *orig_initial_rels = initial_rels;
+	int			orig_length = list_length(root->join_rel_list);
+	int			savelength = orig_length;
 
-	rel = (RelOptInfo *) linitial(root->join_rel_level[levels_needed]);
+	Assert(block_size >= 2);
+	Assert(root->join_rel_level == NULL);
+
+	for (;;)
+	{
+		bool		last_round = (levels_needed <= block_size);
+		int			max_level = last_round ? levels_needed : block_size;
+		RelOptInfo *best = NULL;
+		int			best_level = 1;
+		List	   *remaining_rels = NIL;
+		ListCell   *lc;
+
+		root->join_rel_level = (List **) palloc0((max_level + 1) * sizeof(List *));
+		root->join_rel_level[1] = initial_rels;
+
+		for (int lev = 2; lev <= max_level; lev++)
+		{
+			join_search_level(root, lev);
+			if (root->join_rel_level[lev] == NIL)
+				break;
+			best_level = lev;
+		}
+
+		if (last_round)
+		{
+			if (best_level < levels_needed)
+				break;
+			Assert(list_length(root->join_rel_level[levels_needed]) == 1);
+			best = (RelOptInfo *) linitial(root->join_rel_level[levels_needed]);
+			root->join_rel_level = NULL;
+			return best;
+		}
 
+		/* Pick the cheapest of the largest join rels */
+		if (best_level == 1)
+			break;
+		foreach(lc, root->join_rel_level[best_level])
+		{
+			RelOptInfo *rel = (RelOptInfo *) lfirst(lc);
+
+			if (rel->cheapest_total_path == NULL)
+				continue;
+			if (best == NULL ||
+				rel->cheapest_total_path->total_cost <
+				best->cheapest_total_path->total_cost)
+				best = rel;
+		}
+		if (best == NULL)
+			break;
+
+		root->join_rel_level = NULL;
+
+		/*
+		 * Forget all the join rels built in this round except the chosen one.
+		 * The others remain reachable from its paths, but they must not be
+		 * found by find_join_rel() anymore, or they wouldn't be entered into
+		 * join_rel_level[] when they're built again in the next round.  Throw
+		 * away the hash table too; find_join_rel() will rebuild it if needed.
+		 */
+		root->join_rel_list = list_truncate(root->join_rel_list, savelength);
+		root->join_rel_list = lappend(root->join_rel_list, best);
+		root->join_rel_hash = NULL;
+		savelength++;
+
+		/* Replace the items that the chosen rel was built from */
+		foreach(lc, initial_rels)
+		{
+			RelOptInfo *rel = (RelOptInfo *) lfirst(lc);
+
+			if (!bms_is_subset(rel->relids, best->relids))
+				remaining_rels = lappend(remaining_rels, rel);
+		}
+		initial_rels = lappend(remaining_rels, best);
+		levels_needed = list_length(initial_rels);
+
+		/* has_legal_joinclause() looks at this, see make_rel_from_joinlist */
+		root->initial_rels = initial_rels;
+	}
+
+	/* We got stuck; undo everything and use a regular search instead */
 	root->join_rel_level = NULL;
+	root->join_rel_list = list_truncate(root->join_rel_list, orig_length);
+	root->join_rel_hash = NULL;
+	root->initial_rels = orig_initial_rels;
 
-	return rel;
+	if (enable_geqo && orig_levels_needed >= geqo_threshold)
+		return geqo(root, orig_levels_needed, orig_initial_rels);
+	else
+		return standard_join_search(root, orig_levels_needed, orig_initial_rels);
+}
+
+/*
+ * GUC check_hook for join_search_dp_limit
+ */
+bool
+check_join_search_dp_limit(int *newval, void **extra, GucSource source)
+{
+	/* A search over one item at a time couldn't build any joins */
+	if (*newval == 1)
+	{
+		GUC_check_errdetail("\"%s\" must be 0 or at least 2.",
+							"join_search_dp_limit");
+		return false;
+	}
+	return true;
 }
 
 /*****************************************************************************
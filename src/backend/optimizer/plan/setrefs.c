@@ -1783,7 +1783,13 @@ register_partpruneinfo(PlannerInfo *root, int part_prune_index, int rtoffset)
 				fix_scan_list(root, prelinfo->exec_pruning_steps,
 							  rtoffset, 1);
 
-			for (i = 0; i < prelinfo->nparts; i++)
+			/*
+			 * Only partitions in present_parts can have an entry in the map,
+			 * so there's no need to look at the others, of which there can be
+			 * many.
+			 */
+			i = -1;
+			while ((i = bms_next_member(prelinfo->present_parts, i)) >= 0)
 			{
 				/*
 				 * Non-leaf partitions and partitions that do not have a
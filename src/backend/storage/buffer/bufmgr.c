@@ -62,6 +62,7 @@
 #include "storage/smgr.h"
 #include "storage/standby.h"
 #include "utils/memdebug.h"
+#include "utils/memutils.h"
 #include "utils/ps_status.h"
 #include "utils/rel.h"
 #include "utils/resowner.h"
@@ -518,6 +519,8 @@ static void UnpinBuffer(BufferDesc *buf);
 static void UnpinBufferNoOwner(BufferDesc *buf);
 static void BufferSync(int flags);
 static uint32 WaitBufHdrUnlocked(BufferDesc *buf);
+static int	SyncCheckpointBuffers(CkptSortItem *items, int nitems,
+								  WritebackContext *wb_context, int *nwritten);
 static int	SyncOneBuffer(int buf_id, bool skip_recently_used,
 						  WritebackContext *wb_context);
 static void WaitIO(BufferDesc *buf);
@@ -2135,13 +2138,23 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 
 	victim_buf_hdr->tag = newTag;
 
+	/*
+	 * Let the replacement policy choose the initial usage count, unless
+	 * we're using a ring of buffers, which relies on the usage count being
+	 * one.
+	 */
+	victim_buf_state |= BM_TAG_VALID;
+	if (strategy == NULL)
+		victim_buf_state += StrategyNewBufferUsageCount(newHash) * BUF_USAGECOUNT_ONE;
+	else
+		victim_buf_state += BUF_USAGECOUNT_ONE;
+
 	/*
 	 * Make sure BM_PERMANENT is set for buffers that must be written at every
 	 * checkpoint.  Unlogged buffers only need to be written at shutdown
 	 * checkpoints, except for their "init" forks, which need to be treated
 	 * just like permanent relations.
 	 */
-	victim_buf_state |= BM_TAG_VALID | BUF_USAGECOUNT_ONE;
 	if (relpersistence == RELPERSISTENCE_PERMANENT || forkNum == INIT_FORKNUM)
 		victim_buf_state |= BM_PERMANENT;
 
@@ -2272,9 +2285,14 @@ retry:
  *
  * Returns true if the buffer can be reused, in which case the buffer is only
  * pinned by this backend and marked as invalid, false otherwise.
+ *
+ * If remember_eviction is true, the evicted page is recorded in the 2Q
+ * policy's ghost history.  Callers pass false unless the buffer was chosen by
+ * the clock sweep; pages cycling through a strategy ring, or evicted on
+ * request, must not be treated as re-used when they are read back in.
  */
 static bool
-InvalidateVictimBuffer(BufferDesc *buf_hdr)
+InvalidateVictimBuffer(BufferDesc *buf_hdr, bool remember_eviction)
 {
 	uint32		buf_state;
 	uint32		hash;
@@ -2334,6 +2352,10 @@ InvalidateVictimBuffer(BufferDesc *buf_hdr)
 
 	LWLockRelease(partition_lock);
 
+	if (remember_eviction &&
+		buffer_replacement_policy == BUFFER_REPLACEMENT_2Q)
+		StrategyRememberEvicted(hash);
+
 	Assert(!(buf_state & (BM_DIRTY | BM_VALID | BM_TAG_VALID)));
 	Assert(BUF_STATE_GET_REFCOUNT(buf_state) > 0);
 	Assert(BUF_STATE_GET_REFCOUNT(pg_atomic_read_u32(&buf_hdr->state)) > 0);
@@ -2476,7 +2498,8 @@ again:
 	 * can fail because another backend could have pinned or dirtied the
 	 * buffer.
 	 */
-	if ((buf_state & BM_TAG_VALID) && !InvalidateVictimBuffer(buf_hdr))
+	if ((buf_state & BM_TAG_VALID) &&
+		!InvalidateVictimBuffer(buf_hdr, !from_ring))
 	{
 		UnpinBuffer(buf_hdr);
 		goto again;
@@ -3523,46 +3546,36 @@ BufferSync(int flags)
 	num_written = 0;
 	while (!binaryheap_empty(ts_heap))
 	{
-		BufferDesc *bufHdr = NULL;
 		CkptTsStatus *ts_stat = (CkptTsStatus *)
 			DatumGetPointer(binaryheap_first(ts_heap));
+		int			nconsumed;
+		int			nwritten;
 
-		buf_id = CkptBufferIds[ts_stat->index].buf_id;
-		Assert(buf_id != -1);
-
-		bufHdr = GetBufferDescriptor(buf_id);
-
-		num_processed++;
+		Assert(CkptBufferIds[ts_stat->index].buf_id != -1);
 
 		/*
-		 * We don't need to acquire the lock here, because we're only looking
-		 * at a single bit. It's possible that someone else writes the buffer
-		 * and clears the flag right after we check, but that doesn't matter
-		 * since SyncOneBuffer will then do nothing.  However, there is a
-		 * further race condition: it's conceivable that between the time we
-		 * examine the bit here and the time SyncOneBuffer acquires the lock,
-		 * someone else not only wrote the buffer but replaced it with another
-		 * page and dirtied it.  In that improbable case, SyncOneBuffer will
-		 * write the buffer though we didn't need to.  It doesn't seem worth
-		 * guarding against this, though.
+		 * Write the next buffer of this tablespace, together with any buffers
+		 * holding the blocks that directly follow it in the same relation
+		 * fork.
 		 */
-		if (pg_atomic_read_u32(&bufHdr->state) & BM_CHECKPOINT_NEEDED)
-		{
-			if (SyncOneBuffer(buf_id, false, &wb_context) & BUF_WRITTEN)
-			{
-				TRACE_POSTGRESQL_BUFFER_SYNC_WRITTEN(buf_id);
-				PendingCheckpointerStats.buffers_written++;
-				num_written++;
-			}
-		}
+		nconsumed = SyncCheckpointBuffers(&CkptBufferIds[ts_stat->index],
+										  ts_stat->num_to_scan - ts_stat->num_scanned,
+										  &wb_context, &nwritten);
+		Assert(nconsumed >= 1 && nwritten <= nconsumed);
+
+		for (i = 0; i < nwritten; i++)
+			TRACE_POSTGRESQL_BUFFER_SYNC_WRITTEN(CkptBufferIds[ts_stat->index + i].buf_id);
+		PendingCheckpointerStats.buffers_written += nwritten;
+		num_written += nwritten;
+		num_processed += nconsumed;
 
 		/*
 		 * Measure progress independent of actually having to flush the buffer
 		 * - otherwise writing become unbalanced.
 		 */
-		ts_stat->progress += ts_stat->progress_slice;
-		ts_stat->num_scanned++;
-		ts_stat->index++;
+		ts_stat->progress += ts_stat->progress_slice * nconsumed;
+		ts_stat->num_scanned += nconsumed;
+		ts_stat->index += nconsumed;
 
 		/* Have all the buffers from the tablespace been processed? */
 		if (ts_stat->num_scanned == ts_stat->num_to_scan)
@@ -3897,6 +3910,228 @@ BgBufferSync(WritebackContext *wb_context)
 	return (bufs_to_lap == 0 && recent_alloc == 0);
 }
 
+/*
+ * SyncCheckpointBuffers -- write out the next buffers during a checkpoint.
+ *
+ * items points into the sorted CkptBufferIds array, and at most nitems
+ * entries, all in the same tablespace, may be looked at.  The first entry's
+ * buffer is written if it still needs to be, like SyncOneBuffer() would.
+ * Buffers of the following entries are added to the same write as long as
+ * they hold the next consecutive blocks of the same relation fork, so runs of
+ * dirty blocks go to the kernel in a single smgrwritev() call of up to
+ * io_combine_limit blocks, rather than one block at a time.
+ *
+ * We never wait for a content lock or an I/O while holding the buffers
+ * already gathered, to avoid deadlocks; such buffers just end the run, and
+ * are dealt with by the next call.
+ *
+ * Returns the number of entries consumed, which is at least one, and sets
+ * *nwritten to the number of buffers written, which are those of the first
+ * *nwritten entries.
+ */
+static int
+SyncCheckpointBuffers(CkptSortItem *items, int nitems,
+					  WritebackContext *wb_context, int *nwritten)
+{
+	static char *checksum_copies = NULL;
+	BufferDesc *bufs[MAX_IO_COMBINE_LIMIT];
+	const void *pages[MAX_IO_COMBINE_LIMIT];
+	int			nbufs = 0;
+	int			maxbufs = Min(nitems, io_combine_limit);
+	BufferTag	tag = {0};
+	RelFileLocator rlocator = {0};
+	SMgrRelation reln;
+	XLogRecPtr	flushlsn = InvalidXLogRecPtr;
+	bool		need_flush = false;
+	ErrorContextCallback errcallback;
+	instr_time	io_start;
+
+	*nwritten = 0;
+
+	for (int i = 0; i < maxbufs; i++)
+	{
+		BufferDesc *bufHdr = GetBufferDescriptor(items[i].buf_id);
+		uint32		buf_state;
+
+		/* Later entries must hold the next block of the same fork */
+		if (i > 0 &&
+			(items[i].relNumber != items[0].relNumber ||
+			 items[i].forkNum != items[0].forkNum ||
+			 items[i].blockNum != items[0].blockNum + i))
+			break;
+
+		/*
+		 * We don't need to acquire the lock here, because we're only looking
+		 * at a single bit.  It's possible that someone else writes the buffer
+		 * and clears the flag right after we check, but that doesn't matter
+		 * since we'll then find it clean, or fail to start the I/O, below.
+		 * However, there is a further race condition: it's conceivable that
+		 * between the time we examine the bit here and the time we acquire
+		 * the lock, someone else not only wrote the buffer but replaced it
+		 * with another page and dirtied it.  For the first entry, we will
+		 * then write the buffer though we didn't need to.  It doesn't seem
+		 * worth guarding against this, though.  For later entries, the tag
+		 * check below ends the run instead.
+		 */
+		if (!(pg_atomic_read_u32(&bufHdr->state) & BM_CHECKPOINT_NEEDED))
+			break;
+
+		/* Make sure we can handle the pin */
+		ReservePrivateRefCountEntry();
+		ResourceOwnerEnlarge(CurrentResourceOwner);
+
+		buf_state = LockBufHdr(bufHdr);
+
+		if (!(buf_state & BM_VALID) || !(buf_state & BM_DIRTY) ||
+			(i > 0 &&
+			 (!BufTagMatchesRelFileLocator(&bufHdr->tag, &rlocator) ||
+			  BufTagGetForkNum(&bufHdr->tag) != BufTagGetForkNum(&tag) ||
+			  bufHdr->tag.blockNum != tag.blockNum + i)))
+		{
+			UnlockBufHdr(bufHdr, buf_state);
+			break;
+		}
+
+		PinBuffer_Locked(bufHdr);
+
+		if (i == 0)
+			LWLockAcquire(BufferDescriptorGetContentLock(bufHdr), LW_SHARED);
+		else if (!LWLockConditionalAcquire(BufferDescriptorGetContentLock(bufHdr),
+										   LW_SHARED))
+		{
+			UnpinBuffer(bufHdr);
+			break;
+		}
+
+		/*
+		 * Start the I/O.  This fails if someone else wrote the buffer in the
+		 * meantime, or, for the buffers after the first, is writing it now.
+		 */
+		if (!StartBufferIO(bufHdr, false, i > 0))
+		{
+			LWLockRelease(BufferDescriptorGetContentLock(bufHdr));
+			UnpinBuffer(bufHdr);
+			break;
+		}
+
+		if (i == 0)
+		{
+			tag = bufHdr->tag;
+			rlocator = BufTagGetRelFileLocator(&tag);
+		}
+		bufs[nbufs++] = bufHdr;
+	}
+
+	/* Nothing to write?  Then we've consumed just the first entry. */
+	if (nbufs == 0)
+		return 1;
+
+	/* Setup error traceback support for ereport() */
+	errcallback.callback = shared_buffer_write_error_callback;
+	errcallback.arg = bufs[0];
+	errcallback.previous = error_context_stack;
+	error_context_stack = &errcallback;
+
+	reln = smgropen(rlocator, INVALID_PROC_NUMBER);
+
+	for (int i = 0; i < nbufs; i++)
+	{
+		BufferDesc *bufHdr = bufs[i];
+		uint32		buf_state;
+		XLogRecPtr	recptr;
+
+		TRACE_POSTGRESQL_BUFFER_FLUSH_START(BufTagGetForkNum(&tag),
+											tag.blockNum + i,
+											reln->smgr_rlocator.locator.spcOid,
+											reln->smgr_rlocator.locator.dbOid,
+											reln->smgr_rlocator.locator.relNumber);
+
+		/* See FlushBuffer() */
+		buf_state = LockBufHdr(bufHdr);
+		recptr = BufferGetLSN(bufHdr);
+		buf_state &= ~BM_JUST_DIRTIED;
+		UnlockBufHdr(bufHdr, buf_state);
+
+		if (buf_state & BM_PERMANENT)
+		{
+			need_flush = true;
+			if (recptr > flushlsn)
+				flushlsn = recptr;
+		}
+	}
+
+	/* Obey the WAL rule for all the buffers at once, see FlushBuffer() */
+	if (need_flush)
+		XLogFlush(flushlsn);
+
+	/*
+	 * Set the page checksums.  As in FlushBuffer(), that must be done on
+	 * private copies, since hint bits may change under a share lock.
+	 */
+	if (DataChecksumsEnabled())
+	{
+		if (checksum_copies == NULL)
+			checksum_copies = MemoryContextAllocAligned(TopMemoryContext,
+														MAX_IO_COMBINE_LIMIT * BLCKSZ,
+														PG_IO_ALIGN_SIZE,
+														0);
+
+		for (int i = 0; i < nbufs; i++)
+		{
+			char	   *copy = checksum_copies + i * BLCKSZ;
+
+			memcpy(copy, BufHdrGetBlock(bufs[i]), BLCKSZ);
+			PageSetChecksumInplace((Page) copy, tag.blockNum + i);
+			pages[i] = copy;
+		}
+	}
+	else
+	{
+		for (int i = 0; i < nbufs; i++)
+			pages[i] = BufHdrGetBlock(bufs[i]);
+	}
+
+	io_start = pgstat_prepare_io_time(track_io_timing);
+
+	smgrwritev(reln, BufTagGetForkNum(&tag), tag.blockNum, pages, nbufs,
+			   false);
+
+	/*
+	 * Count a combined write as one operation, like combined reads, so that
+	 * pg_stat_io shows the average write size.
+	 */
+	pgstat_count_io_op_time(IOOBJECT_RELATION, IOCONTEXT_NORMAL,
+							IOOP_WRITE, io_start, 1, nbufs * BLCKSZ);
+
+	pgBufferUsage.shared_blks_written += nbufs;
+
+	for (int i = 0; i < nbufs; i++)
+	{
+		BufferDesc *bufHdr = bufs[i];
+		BufferTag	buftag = bufHdr->tag;
+
+		TerminateBufferIO(bufHdr, true, 0, true, false);
+
+		TRACE_POSTGRESQL_BUFFER_FLUSH_DONE(BufTagGetForkNum(&tag),
+										   tag.blockNum + i,
+										   reln->smgr_rlocator.locator.spcOid,
+										   reln->smgr_rlocator.locator.dbOid,
+										   reln->smgr_rlocator.locator.relNumber);
+
+		LWLockRelease(BufferDescriptorGetContentLock(bufHdr));
+		UnpinBuffer(bufHdr);
+
+		/* Only checkpointer calls this, so IOContext is IOCONTEXT_NORMAL */
+		ScheduleBufferTagForWriteback(wb_context, IOCONTEXT_NORMAL, &buftag);
+	}
+
+	/* Pop the error context stack */
+	error_context_stack = errcallback.previous;
+
+	*nwritten = nbufs;
+	return nbufs;
+}
+
 /*
  * SyncOneBuffer -- process a single buffer during syncing.
  *
@@ -6607,7 +6842,7 @@ EvictUnpinnedBufferInternal(BufferDesc *desc, bool *buffer_flushed)
 	}
 
 	/* This will return false if it becomes dirty or someone else pins it. */
-	result = InvalidateVictimBuffer(desc);
+	result = InvalidateVictimBuffer(desc, false);
 
 	UnpinBuffer(desc);
 
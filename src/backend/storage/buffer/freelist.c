@@ -64,6 +64,20 @@ typedef struct
 /* Pointers to shared state */
 static BufferStrategyControl *StrategyControl = NULL;
 
+/*
+ * Ghost history for the 2Q replacement policy.  It remembers the buffer
+ * mapping hash codes of recently evicted pages, in a direct-mapped table with
+ * one slot per buffer, so each slot holds the most recent eviction that
+ * hashed to it.  Zero means empty; the low bit of stored hash codes is always
+ * set.  Collisions can make a page look recently evicted when it wasn't, but
+ * that just gives it a better start in the buffer pool.  NULL unless the 2Q
+ * policy is in use.
+ */
+static pg_atomic_uint32 *StrategyGhosts = NULL;
+
+/* GUC variable */
+int			buffer_replacement_policy = BUFFER_REPLACEMENT_CLOCK;
+
 /*
  * Private (non-shared) state for managing a ring of shared buffers to re-use.
  * This is currently the only kind of BufferAccessStrategy object, but someday
@@ -460,6 +474,10 @@ StrategyShmemSize(void)
 	/* size of the shared replacement strategy control block */
 	size = add_size(size, MAXALIGN(sizeof(BufferStrategyControl)));
 
+	/* size of the ghost history, if we need one */
+	if (buffer_replacement_policy == BUFFER_REPLACEMENT_2Q)
+		size = add_size(size, mul_size(NBuffers, sizeof(pg_atomic_uint32)));
+
 	return size;
 }
 
@@ -523,6 +541,68 @@ StrategyInitialize(bool init)
 	}
 	else
 		Assert(!init);
+
+	if (buffer_replacement_policy == BUFFER_REPLACEMENT_2Q)
+	{
+		StrategyGhosts = (pg_atomic_uint32 *)
+			ShmemInitStruct("Buffer Strategy Ghosts",
+							NBuffers * sizeof(pg_atomic_uint32),
+							&found);
+		if (!found)
+		{
+			for (int i = 0; i < NBuffers; i++)
+				pg_atomic_init_u32(&StrategyGhosts[i], 0);
+		}
+	}
+}
+
+/*
+ * StrategyNewBufferUsageCount -- usage count for a newly loaded page
+ *
+ * Returns the usage count to give a buffer that is being loaded with the page
+ * whose buffer mapping hash code is given, by a backend that is not using a
+ * buffer access strategy.
+ *
+ * The clock sweep starts every newly loaded page with a usage count of one,
+ * so that pages that are read once, by large index scans or nested-loop
+ * lookups, push hot pages out nearly as fast as pages that are re-used.  The
+ * 2Q policy instead starts new pages on probation, with a usage count of
+ * zero: unless they are accessed again before the clock hand comes around,
+ * they are the first to be reclaimed.  Pages found in the ghost history were
+ * evicted recently and are now read back in, which shows that they are
+ * re-used; they start out with a usage count of two.
+ */
+uint32
+StrategyNewBufferUsageCount(uint32 hashcode)
+{
+	pg_atomic_uint32 *ghost;
+
+	if (buffer_replacement_policy != BUFFER_REPLACEMENT_2Q)
+		return 1;
+
+	ghost = &StrategyGhosts[hashcode % NBuffers];
+	if (pg_atomic_read_u32(ghost) == (hashcode | 1))
+	{
+		pg_atomic_write_u32(ghost, 0);
+		return 2;
+	}
+
+	return 0;
+}
+
+/*
+ * StrategyRememberEvicted -- record the eviction of a page
+ *
+ * Remembers the buffer mapping hash code of an evicted page in the ghost
+ * history, for StrategyNewBufferUsageCount().  Only to be called with the 2Q
+ * policy, for pages evicted by the clock sweep.
+ */
+void
+StrategyRememberEvicted(uint32 hashcode)
+{
+	Assert(buffer_replacement_policy == BUFFER_REPLACEMENT_2Q);
+
+	pg_atomic_write_u32(&StrategyGhosts[hashcode % NBuffers], hashcode | 1);
 }
 
 
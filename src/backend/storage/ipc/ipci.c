@@ -27,6 +27,7 @@
 #include "commands/async.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "port/pg_numa.h"
 #include "postmaster/autovacuum.h"
 #include "postmaster/bgworker_internals.h"
 #include "postmaster/bgwriter.h"
@@ -50,6 +51,7 @@
 #include "storage/procsignal.h"
 #include "storage/sinvaladt.h"
 #include "utils/guc.h"
+#include "utils/guc_hooks.h"
 #include "utils/injection_point.h"
 
 /* GUCs */
@@ -222,6 +224,23 @@ CreateSharedMemoryAndSemaphores(void)
 	Assert(strcmp("unknown",
 				  GetConfigOption("huge_pages_status", false, false)) != 0);
 
+	/*
+	 * Apply the NUMA placement policy before anything else touches the
+	 * segment, as the kernel places each page on a node when it is first
+	 * touched.  Only the header has been written so far.
+	 */
+	if (numa_shared_memory == NUMA_SHMEM_INTERLEAVE)
+	{
+		if (pg_numa_init() == -1)
+			ereport(FATAL,
+					(errmsg("NUMA is not supported on this system"),
+					 errhint("Set \"%s\" to \"%s\".",
+							 "numa_shared_memory", "off")));
+		if (pg_numa_interleave_memory(seghdr, seghdr->totalsize) != 0)
+			ereport(FATAL,
+					(errmsg("could not interleave shared memory across NUMA nodes: %m")));
+	}
+
 	InitShmemAccess(seghdr);
 
 	/*
@@ -386,3 +405,20 @@ InitializeShmemGUCs(void)
 	sprintf(buf, "%d", num_semas);
 	SetConfigOption("num_os_semaphores", buf, PGC_INTERNAL, PGC_S_DYNAMIC_DEFAULT);
 }
+
+/*
+ * GUC check_hook for numa_shared_memory
+ */
+bool
+check_numa_shared_memory(int *newval, void **extra, GucSource source)
+{
+#ifndef USE_LIBNUMA
+	if (*newval != NUMA_SHMEM_OFF)
+	{
+		GUC_check_errdetail("\"%s\" must be \"%s\" on this platform.",
+							"numa_shared_memory", "off");
+		return false;
+	}
+#endif
+	return true;
+}
@@ -2541,6 +2541,41 @@ LockReleaseAll(LOCKMETHODID lockmethodid, bool allLocks)
 #endif
 }
 
+/*
+ * LockHeldInSession -- Does the current process hold any session locks of
+ *		the specified lock method?
+ */
+bool
+LockHeldInSession(LOCKMETHODID lockmethodid)
+{
+	HASH_SEQ_STATUS status;
+	LOCALLOCK  *locallock;
+
+	if (lockmethodid <= 0 || lockmethodid >= lengthof(LockMethods))
+		elog(ERROR, "unrecognized lock method: %d", lockmethodid);
+
+	hash_seq_init(&status, LockMethodLocalHash);
+
+	while ((locallock = (LOCALLOCK *) hash_seq_search(&status)) != NULL)
+	{
+		/* Ignore items that are not of the specified lock method */
+		if (LOCALLOCK_LOCKMETHOD(*locallock) != lockmethodid)
+			continue;
+
+		/* Session locks are those held without a resource owner */
+		for (int i = 0; i < locallock->numLockOwners; i++)
+		{
+			if (locallock->lockOwners[i].owner == NULL)
+			{
+				hash_seq_term(&status);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 /*
  * LockReleaseSession -- Release all session locks of the specified lock method
  *		that are held by the current process.
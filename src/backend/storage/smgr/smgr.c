@@ -273,6 +273,7 @@ smgropen(RelFileLocator rlocator, ProcNumber backend)
 		reln->smgr_targblock = InvalidBlockNumber;
 		for (int i = 0; i <= MAX_FORKNUM; ++i)
 			reln->smgr_cached_nblocks[i] = InvalidBlockNumber;
+		reln->smgr_extend_by = 0;
 		reln->smgr_which = 0;	/* we only have md.c at present */
 
 		/* it is not pinned yet */
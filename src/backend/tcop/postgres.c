@@ -4650,35 +4650,41 @@ PostgresMain(const char *dbname, const char *username)
 			ReportChangedGUCOptions();
 
 			/*
-			 * The first time this backend is ready for query, log the
-			 * durations of the different components of connection
-			 * establishment and setup.
+			 * The first time this backend is ready for query, report the
+			 * connection setup time to the cumulative statistics system, and
+			 * log the durations of the different components of connection
+			 * establishment and setup if requested.
 			 */
 			if (conn_timing.ready_for_use == TIMESTAMP_MINUS_INFINITY &&
-				(log_connections & LOG_CONNECTION_SETUP_DURATIONS) &&
 				IsExternalConnectionBackend(MyBackendType))
 			{
-				uint64		total_duration,
-							fork_duration,
-							auth_duration;
-
 				conn_timing.ready_for_use = GetCurrentTimestamp();
 
-				total_duration =
-					TimestampDifferenceMicroseconds(conn_timing.socket_create,
-													conn_timing.ready_for_use);
-				fork_duration =
-					TimestampDifferenceMicroseconds(conn_timing.fork_start,
-													conn_timing.fork_end);
-				auth_duration =
-					TimestampDifferenceMicroseconds(conn_timing.auth_start,
-													conn_timing.auth_end);
-
-				ereport(LOG,
-						errmsg("connection ready: setup total=%.3f ms, fork=%.3f ms, authentication=%.3f ms",
-							   (double) total_duration / NS_PER_US,
-							   (double) fork_duration / NS_PER_US,
-							   (double) auth_duration / NS_PER_US));
+				pgstat_report_session_setup(conn_timing.socket_create,
+											conn_timing.ready_for_use);
+
+				if (log_connections & LOG_CONNECTION_SETUP_DURATIONS)
+				{
+					uint64		total_duration,
+								fork_duration,
+								auth_duration;
+
+					total_duration =
+						TimestampDifferenceMicroseconds(conn_timing.socket_create,
+														conn_timing.ready_for_use);
+					fork_duration =
+						TimestampDifferenceMicroseconds(conn_timing.fork_start,
+														conn_timing.fork_end);
+					auth_duration =
+						TimestampDifferenceMicroseconds(conn_timing.auth_start,
+														conn_timing.auth_end);
+
+					ereport(LOG,
+							errmsg("connection ready: setup total=%.3f ms, fork=%.3f ms, authentication=%.3f ms",
+								   (double) total_duration / NS_PER_US,
+								   (double) fork_duration / NS_PER_US,
+								   (double) auth_duration / NS_PER_US));
+				}
 			}
 
 			ReadyForQuery(whereToSendOutput);
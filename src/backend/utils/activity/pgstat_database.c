@@ -237,6 +237,23 @@ pgstat_report_connect(Oid dboid)
 	dbentry->sessions++;
 }
 
+/*
+ * Notify the stats system that a new session, whose connection was accepted
+ * at start, has become ready for its first query at ready.
+ */
+void
+pgstat_report_session_setup(TimestampTz start, TimestampTz ready)
+{
+	PgStat_StatDBEntry *dbentry;
+
+	if (!pgstat_should_report_connstat())
+		return;
+
+	dbentry = pgstat_prep_database_pending(MyDatabaseId);
+	dbentry->session_setup_time +=
+		(PgStat_Counter) TimestampDifferenceMicroseconds(start, ready);
+}
+
 /*
  * Notify the stats system of a disconnect.
  */
@@ -475,6 +492,7 @@ pgstat_database_flush_cb(PgStat_EntryRef *entry_ref, bool nowait)
 	PGSTAT_ACCUM_DBCOUNT(session_time);
 	PGSTAT_ACCUM_DBCOUNT(active_time);
 	PGSTAT_ACCUM_DBCOUNT(idle_in_transaction_time);
+	PGSTAT_ACCUM_DBCOUNT(session_setup_time);
 	PGSTAT_ACCUM_DBCOUNT(sessions_abandoned);
 	PGSTAT_ACCUM_DBCOUNT(sessions_fatal);
 	PGSTAT_ACCUM_DBCOUNT(sessions_killed);
@@ -23,10 +23,13 @@
 
 #include "access/sysattr.h"
 #include "access/table.h"
+#include "catalog/namespace.h"
 #include "catalog/pg_tablespace.h"
 #include "catalog/pg_type.h"
 #include "catalog/system_fk_info.h"
+#include "commands/async.h"
 #include "commands/dbcommands.h"
+#include "commands/prepare.h"
 #include "commands/tablespace.h"
 #include "common/keywords.h"
 #include "funcapi.h"
@@ -39,10 +42,14 @@
 #include "rewrite/rewriteHandler.h"
 #include "storage/fd.h"
 #include "storage/latch.h"
+#include "storage/lock.h"
 #include "tcop/tcopprot.h"
+#include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/fmgroids.h"
+#include "utils/guc.h"
 #include "utils/lsyscache.h"
+#include "utils/portal.h"
 #include "utils/ruleutils.h"
 #include "utils/syscache.h"
 #include "utils/timestamp.h"
@@ -218,6 +225,40 @@ current_query(PG_FUNCTION_ARGS)
 		PG_RETURN_NULL();
 }
 
+/*
+ * pg_session_state()
+ *	Report the kinds of session-level state held by the current session.
+ *
+ * Each of these ties the session to its server process: a connection pooler
+ * can't hand the server process to another client, or move the client to
+ * another server process, without losing or leaking the state.  An empty
+ * array means the session could safely be pooled at transaction boundaries.
+ */
+Datum
+pg_session_state(PG_FUNCTION_ARGS)
+{
+	Datum		states[6];
+	int			nstates = 0;
+	Oid			tempNamespaceId;
+	Oid			tempToastNamespaceId;
+
+	GetTempNamespaceState(&tempNamespaceId, &tempToastNamespaceId);
+	if (OidIsValid(tempNamespaceId))
+		states[nstates++] = CStringGetTextDatum("temp_objects");
+	if (LockHeldInSession(USER_LOCKMETHOD))
+		states[nstates++] = CStringGetTextDatum("advisory_locks");
+	if (HaveSessionOptions())
+		states[nstates++] = CStringGetTextDatum("settings");
+	if (HavePreparedStatements())
+		states[nstates++] = CStringGetTextDatum("prepared_statements");
+	if (ThereAreHoldablePortals())
+		states[nstates++] = CStringGetTextDatum("holdable_cursors");
+	if (IsListeningOnAnyChannel())
+		states[nstates++] = CStringGetTextDatum("listen");
+
+	PG_RETURN_ARRAYTYPE_P(construct_array_builtin(states, nstates, TEXTOID));
+}
+
 /* Function to find out which databases make use of a tablespace */
 
 Datum
@@ -1210,6 +1210,9 @@ PG_STAT_GET_DBENTRY_FLOAT8_MS(idle_in_transaction_time)
 /* pg_stat_get_db_session_time */
 PG_STAT_GET_DBENTRY_FLOAT8_MS(session_time)
 
+/* pg_stat_get_db_session_setup_time */
+PG_STAT_GET_DBENTRY_FLOAT8_MS(session_setup_time)
+
 Datum
 pg_stat_get_checkpointer_num_timed(PG_FUNCTION_ARGS)
 {
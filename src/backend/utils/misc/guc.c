@@ -1997,6 +1997,38 @@ pg_timezone_abbrev_initialize(void)
 }
 
 
+/*
+ * Are any options set in this session that RESET ALL would revert?
+ *
+ * This is true once SET (or set_config() and the like) has changed a
+ * variable from the value established by the configuration files and the
+ * client's connection options.
+ */
+bool
+HaveSessionOptions(void)
+{
+	dlist_iter	iter;
+
+	dlist_foreach(iter, &guc_nondef_list)
+	{
+		struct config_generic *gconf = dlist_container(struct config_generic,
+													   nondef_link, iter.cur);
+
+		/* Same tests as in ResetAllOptions */
+		if (gconf->context != PGC_SUSET &&
+			gconf->context != PGC_USERSET)
+			continue;
+		if (gconf->flags & GUC_NO_RESET_ALL)
+			continue;
+		if (gconf->source <= PGC_S_OVERRIDE)
+			continue;
+
+		return true;
+	}
+
+	return false;
+}
+
 /*
  * Reset all options to their saved default values (implements RESET ALL)
  */
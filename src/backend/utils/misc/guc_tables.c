@@ -378,6 +378,18 @@ static const struct config_enum_entry huge_pages_status_options[] = {
 	{NULL, 0, false}
 };
 
+static const struct config_enum_entry buffer_replacement_policy_options[] = {
+	{"clock", BUFFER_REPLACEMENT_CLOCK, false},
+	{"2q", BUFFER_REPLACEMENT_2Q, false},
+	{NULL, 0, false}
+};
+
+static const struct config_enum_entry numa_shared_memory_options[] = {
+	{"off", NUMA_SHMEM_OFF, false},
+	{"interleave", NUMA_SHMEM_INTERLEAVE, false},
+	{NULL, 0, false}
+};
+
 static const struct config_enum_entry recovery_prefetch_options[] = {
 	{"off", RECOVERY_PREFETCH_OFF, false},
 	{"on", RECOVERY_PREFETCH_ON, false},
@@ -579,6 +591,7 @@ static int	ssl_renegotiation_limit;
 int			huge_pages = HUGE_PAGES_TRY;
 int			huge_page_size;
 int			huge_pages_status = HUGE_PAGES_UNKNOWN;
+int			numa_shared_memory = NUMA_SHMEM_OFF;
 
 /*
  * These variables are all dummies that don't do anything, except in some
@@ -2210,6 +2223,27 @@ struct config_int ConfigureNamesInt[] =
 		8, 1, INT_MAX,
 		NULL, NULL, NULL
 	},
+	{
+		{"join_search_dp_limit", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the number of FROM items beyond which the join order is searched in steps."),
+			gettext_noop("Join orders are searched exhaustively for at most "
+						 "this many FROM items at a time. 0 disables."),
+			GUC_EXPLAIN
+		},
+		&join_search_dp_limit,
+		0, 0, INT_MAX,
+		check_join_search_dp_limit, NULL, NULL
+	},
+	{
+		{"jit_expression_threshold", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the number of evaluations of an expression after which it is JIT compiled."),
+			gettext_noop("0 compiles expressions at executor startup."),
+			GUC_EXPLAIN
+		},
+		&jit_expression_threshold,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
 	{
 		{"geqo_threshold", PGC_USERSET, QUERY_TUNING_GEQO,
 			gettext_noop("Sets the threshold of FROM items beyond which GEQO is used."),
@@ -5305,6 +5339,26 @@ struct config_enum ConfigureNamesEnum[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"numa_shared_memory", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the placement of shared memory on NUMA nodes."),
+			NULL
+		},
+		&numa_shared_memory,
+		NUMA_SHMEM_OFF, numa_shared_memory_options,
+		check_numa_shared_memory, NULL, NULL
+	},
+
+	{
+		{"buffer_replacement_policy", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the page replacement policy of the shared buffer pool."),
+			NULL
+		},
+		&buffer_replacement_policy,
+		BUFFER_REPLACEMENT_CLOCK, buffer_replacement_policy_options,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"huge_pages_status", PGC_INTERNAL, PRESET_OPTIONS,
 			gettext_noop("Indicates the status of huge pages."),
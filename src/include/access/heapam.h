@@ -399,6 +399,14 @@ extern void log_heap_prune_and_freeze(Relation relation, Buffer buffer,
 /* in heap/vacuumlazy.c */
 extern void heap_vacuum_rel(Relation rel,
 							const VacuumParams params, BufferAccessStrategy bstrategy);
+extern void heap_vacuum_parallel_heap_pass(Relation rel,
+										   ParallelVacuumState *pvs,
+										   TidStore *dead_items,
+										   TransactionId oldest_xmin,
+										   BufferAccessStrategy bstrategy,
+										   BlockNumber *vacuumed_pages,
+										   BlockNumber *new_visible_pages,
+										   BlockNumber *new_visible_frozen_pages);
 
 /* in heap/heapam_visibility.c */
 extern bool HeapTupleSatisfiesVisibility(HeapTuple htup, Snapshot snapshot,
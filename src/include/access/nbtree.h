@@ -806,6 +806,24 @@ typedef struct BTScanInsertData
 
 typedef BTScanInsertData *BTScanInsert;
 
+/*
+ * BTInsertCacheData is kept in the IndexInfo's ii_AmCache across all the
+ * insertions into an index made by one statement.  It remembers the leaf page
+ * that the previous tuple was inserted on, so that when tuples arrive in
+ * index order (e.g., COPY of sorted data), the next one can usually be added
+ * to the same page without descending the tree again.  nhits and nmisses
+ * track how useful that has been, so that we can stop trying when insertions
+ * are in random order.  See _bt_search_insert().
+ */
+typedef struct BTInsertCacheData
+{
+	BlockNumber lastleaf;		/* leaf page of previous insertion */
+	uint32		nhits;			/* # of times lastleaf could be used */
+	uint32		nmisses;		/* # of times it couldn't */
+} BTInsertCacheData;
+
+typedef BTInsertCacheData *BTInsertCache;
+
 /*
  * BTInsertStateData is a working area used during insertion.
  *
@@ -841,6 +859,9 @@ typedef struct BTInsertStateData
 	 * with an existing posting list tuple that has its LP_DEAD bit set.
 	 */
 	int			postingoff;
+
+	/* Statement-lifespan insertion cache, or NULL if none */
+	BTInsertCache cache;
 } BTInsertStateData;
 
 typedef BTInsertStateData *BTInsertState;
@@ -1245,7 +1266,7 @@ extern IndexTuple _bt_swap_posting(IndexTuple newitem, IndexTuple oposting,
  */
 extern bool _bt_doinsert(Relation rel, IndexTuple itup,
 						 IndexUniqueCheck checkUnique, bool indexUnchanged,
-						 Relation heapRel);
+						 Relation heapRel, BTInsertCache cache);
 extern void _bt_finish_split(Relation rel, Relation heaprel, Buffer lbuf,
 							 BTStack stack);
 extern Buffer _bt_getstackbuf(Relation rel, Relation heaprel, BTStack stack,
@@ -648,6 +648,26 @@ typedef struct TableAmRoutine
 									const VacuumParams params,
 									BufferAccessStrategy bstrategy);
 
+	/*
+	 * Perform a parallel vacuum worker's share of the pass over the relation
+	 * that removes the items in dead_items, once the indexes no longer point
+	 * to them.  Only needed by AMs whose relation_vacuum callback starts such
+	 * a pass with parallel_vacuum_heap_pass_begin(); the blocks to process
+	 * are claimed with parallel_vacuum_claim_heap_block().  The number of
+	 * pages vacuumed, and newly set all-visible (and all-frozen) in the
+	 * visibility map, are returned for the leader to account for.
+	 *
+	 * This callback is optional.
+	 */
+	void		(*relation_vacuum_parallel_pass) (Relation rel,
+												  ParallelVacuumState *pvs,
+												  TidStore *dead_items,
+												  TransactionId oldest_xmin,
+												  BufferAccessStrategy bstrategy,
+												  BlockNumber *vacuumed_pages,
+												  BlockNumber *new_visible_pages,
+												  BlockNumber *new_visible_frozen_pages);
+
 	/*
 	 * Prepare to analyze block `blockno` of `scan`. The scan has been started
 	 * with table_beginscan_analyze().  See also
@@ -1670,6 +1690,27 @@ table_relation_vacuum(Relation rel, const VacuumParams params,
 	rel->rd_tableam->relation_vacuum(rel, params, bstrategy);
 }
 
+/*
+ * Perform a parallel vacuum worker's share of the pass that removes dead
+ * items from the relation, as started by the leader's relation_vacuum
+ * callback.
+ */
+static inline void
+table_relation_vacuum_parallel_pass(Relation rel, ParallelVacuumState *pvs,
+									TidStore *dead_items,
+									TransactionId oldest_xmin,
+									BufferAccessStrategy bstrategy,
+									BlockNumber *vacuumed_pages,
+									BlockNumber *new_visible_pages,
+									BlockNumber *new_visible_frozen_pages)
+{
+	rel->rd_tableam->relation_vacuum_parallel_pass(rel, pvs, dead_items,
+												   oldest_xmin, bstrategy,
+												   vacuumed_pages,
+												   new_visible_pages,
+												   new_visible_frozen_pages);
+}
+
 /*
  * Prepare to analyze the next block in the read stream. The scan needs to
  * have been  started with table_beginscan_analyze().  Note that this routine
@@ -57,6 +57,6 @@
  */
 
 /*							yyyymmddN */
-#define CATALOG_VERSION_NO	202508131
+#define CATALOG_VERSION_NO	202510192
 
 #endif
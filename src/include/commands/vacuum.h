@@ -394,6 +394,15 @@ extern void parallel_vacuum_cleanup_all_indexes(ParallelVacuumState *pvs,
 												long num_table_tuples,
 												int num_index_scans,
 												bool estimated_count);
+extern int	parallel_vacuum_heap_pass_begin(ParallelVacuumState *pvs,
+											TransactionId oldest_xmin,
+											BlockNumber npages);
+extern void parallel_vacuum_heap_pass_end(ParallelVacuumState *pvs,
+										  BlockNumber *vacuumed_pages,
+										  BlockNumber *new_visible_pages,
+										  BlockNumber *new_visible_frozen_pages);
+extern bool parallel_vacuum_claim_heap_block(ParallelVacuumState *pvs,
+											 BlockNumber blkno);
 extern void parallel_vacuum_main(dsm_segment *seg, shm_toc *toc);
 
 /* in commands/analyze.c */
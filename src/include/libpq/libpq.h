@@ -18,6 +18,7 @@
 
 #include "lib/stringinfo.h"
 #include "libpq/libpq-be.h"
+#include "port/pg_iovec.h"
 #include "storage/latch.h"
 
 
@@ -38,6 +39,7 @@ typedef struct
 	bool		(*is_send_pending) (void);
 	int			(*putmessage) (char msgtype, const char *s, size_t len);
 	void		(*putmessage_noblock) (char msgtype, const char *s, size_t len);
+	int			(*putmessagev) (char msgtype, const struct iovec *iov, int iovcnt);
 } PQcommMethods;
 
 extern const PGDLLIMPORT PQcommMethods *PqCommMethods;
@@ -50,6 +52,8 @@ extern const PGDLLIMPORT PQcommMethods *PqCommMethods;
 	(PqCommMethods->putmessage(msgtype, s, len))
 #define pq_putmessage_noblock(msgtype, s, len) \
 	(PqCommMethods->putmessage_noblock(msgtype, s, len))
+#define pq_putmessagev(msgtype, iov, iovcnt) \
+	(PqCommMethods->putmessagev(msgtype, iov, iovcnt))
 
 /*
  * External functions.
@@ -93,8 +97,10 @@ extern int	secure_open_server(Port *port);
 extern void secure_close(Port *port);
 extern ssize_t secure_read(Port *port, void *ptr, size_t len);
 extern ssize_t secure_write(Port *port, const void *ptr, size_t len);
+extern ssize_t secure_writev(Port *port, const struct iovec *iov, int iovcnt);
 extern ssize_t secure_raw_read(Port *port, void *ptr, size_t len);
 extern ssize_t secure_raw_write(Port *port, const void *ptr, size_t len);
+extern ssize_t secure_raw_writev(Port *port, const struct iovec *iov, int iovcnt);
 
 /*
  * declarations for variables defined in be-secure.c
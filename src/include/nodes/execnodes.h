@@ -147,6 +147,12 @@ typedef struct ExprState
 	 * ExecInitExprRec().
 	 */
 	ErrorSaveContext *escontext;
+
+	/*
+	 * Number of evaluations left until the expression is JIT compiled, if
+	 * compilation has been deferred (see jit_expression_threshold).
+	 */
+	int			jit_countdown;
 } ExprState;
 
 
@@ -758,7 +764,11 @@ typedef struct EState
 	/*
 	 * JIT information. es_jit_flags indicates whether JIT should be performed
 	 * and with which options.  es_jit is created on-demand when JITing is
-	 * performed.
+	 * performed.  es_jit_owner is the resource owner that was current at
+	 * executor startup; if compilation is deferred until expressions are hot
+	 * (see jit_expression_threshold), es_jit is created under it, so that it
+	 * doesn't depend on which owner is current when the first expression
+	 * gets compiled.
 	 *
 	 * es_jit_worker_instr is the combined, on demand allocated,
 	 * instrumentation from all workers. The leader's instrumentation is kept
@@ -766,6 +776,7 @@ typedef struct EState
 	 */
 	int			es_jit_flags;
 	struct JitContext *es_jit;
+	struct ResourceOwnerData *es_jit_owner;
 	struct JitInstrumentation *es_jit_worker_instr;
 
 	/*
@@ -46,6 +46,7 @@ extern PGDLLIMPORT int shared_memory_type;
 extern PGDLLIMPORT int huge_pages;
 extern PGDLLIMPORT int huge_page_size;
 extern PGDLLIMPORT int huge_pages_status;
+extern PGDLLIMPORT int numa_shared_memory;
 
 /* Possible values for huge_pages and huge_pages_status */
 typedef enum
@@ -56,6 +57,13 @@ typedef enum
 	HUGE_PAGES_UNKNOWN,			/* only for huge_pages_status */
 }			HugePagesType;
 
+/* Possible values for numa_shared_memory */
+typedef enum
+{
+	NUMA_SHMEM_OFF,
+	NUMA_SHMEM_INTERLEAVE,
+}			NumaSharedMemoryType;
+
 /* Possible values for shared_memory_type */
 typedef enum
 {
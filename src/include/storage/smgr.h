@@ -46,6 +46,13 @@ typedef struct SMgrRelationData
 	BlockNumber smgr_targblock; /* current insertion target block */
 	BlockNumber smgr_cached_nblocks[MAX_FORKNUM + 1];	/* last known size */
 
+	/*
+	 * Number of pages the relation was recently extended by for insertions,
+	 * used to keep extending by larger amounts while contention on the
+	 * relation extension lock persists.  See RelationAddBlocks().
+	 */
+	uint32		smgr_extend_by;
+
 	/* additional public fields may someday exist here */
 
 	/*
@@ -106,6 +106,19 @@ pg_numa_get_max_node(void)
 	return numa_max_node();
 }
 
+/*
+ * Set the memory policy of the given range to interleave its pages across all
+ * NUMA nodes.  As pages are placed when first touched, this only affects
+ * pages of the range that have not been touched yet.  Returns 0 on success,
+ * or -1 with errno set.
+ */
+int
+pg_numa_interleave_memory(void *ptr, size_t size)
+{
+	return mbind(ptr, size, MPOL_INTERLEAVE, numa_all_nodes_ptr->maskp,
+				 numa_all_nodes_ptr->size + 1, 0);
+}
+
 #else
 
 /* Empty wrappers */
@@ -128,4 +141,11 @@ pg_numa_get_max_node(void)
 	return 0;
 }
 
+int
+pg_numa_interleave_memory(void *ptr, size_t size)
+{
+	errno = ENOSYS;
+	return -1;
+}
+
 #endif
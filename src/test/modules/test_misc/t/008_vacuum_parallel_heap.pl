@@ -0,0 +1,59 @@
+# Copyright (c) 2025, PostgreSQL Global Development Group
+
+# Check that parallel VACUUM shares the second heap pass with its workers.
+# The regression tests can't tell whether any worker took part, so look at
+# the VACUUM VERBOSE output instead.
+
+use strict;
+use warnings FATAL => 'all';
+use PostgreSQL::Test::Cluster;
+use PostgreSQL::Test::Utils;
+use Test::More;
+
+my $node = PostgreSQL::Test::Cluster->new('main');
+$node->init;
+$node->append_conf(
+	'postgresql.conf', qq[
+autovacuum = off
+max_worker_processes = 8
+max_parallel_maintenance_workers = 2
+min_parallel_index_scan_size = 0
+min_parallel_table_scan_size = 0
+]);
+$node->start;
+
+$node->safe_psql(
+	'postgres', qq[
+CREATE TABLE vac_heap (a int, b int, c text) WITH (autovacuum_enabled = off);
+INSERT INTO vac_heap
+  SELECT i, i % 100, repeat('x', 50) FROM generate_series(1, 200000) i;
+CREATE INDEX vac_heap_a ON vac_heap (a);
+CREATE INDEX vac_heap_b ON vac_heap (b);
+CREATE INDEX vac_heap_c ON vac_heap (c);
+DELETE FROM vac_heap WHERE a % 3 = 0;
+]);
+
+my ($ret, $stdout, $stderr) = $node->psql('postgres',
+	'VACUUM (VERBOSE, PARALLEL 2) vac_heap;');
+is($ret, 0, 'parallel VACUUM succeeds');
+like(
+	$stderr,
+	qr/launched [1-9]\d* parallel vacuum workers? for heap vacuuming/,
+	'workers were launched for the second heap pass');
+like(
+	$stderr,
+	qr/parallel heap vacuuming: \d+ pages vacuumed by parallel workers/,
+	'VACUUM VERBOSE reports the pages vacuumed by parallel workers');
+
+# Every dead item must be gone, whoever vacuumed its page
+is( $node->safe_psql(
+		'postgres',
+		q{SELECT count(*), sum(a) FROM vac_heap WHERE a % 3 = 0}),
+	'0|',
+	'deleted rows are gone');
+is($node->safe_psql('postgres', q{SELECT count(*) FROM vac_heap}),
+	'133334', 'remaining rows are intact');
+
+$node->stop;
+
+done_testing();
@@ -1649,3 +1649,43 @@ drop table agg_hash_1;
 drop table agg_hash_2;
 drop table agg_hash_3;
 drop table agg_hash_4;
+
+-- Defer JIT compilation of expressions until they have been evaluated often
+-- enough.  The filter crosses the threshold, the expression over the VALUES
+-- list doesn't; either way, the results must not change.
+set jit_above_cost = 0;
+set jit_expression_threshold = 10;
+
+select count(*), sum(g * 2 + 1) from agg_data_2k where g % 3 = 0;
+select sum(a * 2) from (values (1), (2), (3)) v(a);
+
+-- The expression may first be compiled while a subtransaction is running
+-- the query; the compiled code must survive the subtransaction's abort.
+do $$
+declare
+  c cursor for select g * 2 + 1 as x from agg_data_2k where g % 3 = 0;
+  r record;
+  total bigint := 0;
+begin
+  open c;
+  begin
+    for i in 1..20 loop
+      fetch c into r;
+      total := total + r.x;
+    end loop;
+    raise exception 'roll back';
+  exception when others then
+    null;
+  end;
+  loop
+    fetch c into r;
+    exit when not found;
+    total := total + r.x;
+  end loop;
+  close c;
+  raise notice 'total: %', total;
+end
+$$;
+
+reset jit_expression_threshold;
+set jit_above_cost to default;
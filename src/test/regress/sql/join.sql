@@ -3658,3 +3658,142 @@ SELECT COUNT(*) FROM onek t1 LEFT JOIN tenk1 t2
     ON (t2.thousand = t1.tenthous OR t2.thousand = t1.thousand);
 SELECT COUNT(*) FROM onek t1 LEFT JOIN tenk1 t2
     ON (t2.thousand = t1.tenthous OR t2.thousand = t1.thousand);
+
+--
+-- Test stepwise join search with join_search_dp_limit.  Every query is run
+-- with the regular search first, for comparison.
+--
+CREATE TEMP TABLE idp_a AS SELECT g AS a FROM generate_series(1, 10) g;
+CREATE TEMP TABLE idp_b AS SELECT g AS a FROM generate_series(1, 10, 2) g;
+CREATE TEMP TABLE idp_c AS SELECT g AS a FROM generate_series(3, 10, 3) g;
+CREATE TEMP TABLE idp_d AS SELECT g AS a FROM generate_series(1, 5) g;
+CREATE TEMP TABLE idp_t1 AS SELECT g AS x, g AS y FROM generate_series(1, 2) g;
+CREATE TEMP TABLE idp_t2 AS SELECT g AS x, g AS y FROM generate_series(1, 20) g;
+CREATE TEMP TABLE idp_t3 AS SELECT g AS x, g AS y FROM generate_series(1, 40) g;
+CREATE TEMP TABLE idp_t4 AS SELECT g AS x, g AS y FROM generate_series(1, 80) g;
+CREATE TEMP TABLE idp_t5 AS SELECT g AS x, g AS y FROM generate_series(1, 160) g;
+CREATE TABLE idp_p (a int) PARTITION BY RANGE (a);
+CREATE TABLE idp_p1 PARTITION OF idp_p FOR VALUES FROM (1) TO (6);
+CREATE TABLE idp_p2 PARTITION OF idp_p FOR VALUES FROM (6) TO (11);
+INSERT INTO idp_p SELECT generate_series(1, 10);
+ANALYZE idp_a, idp_b, idp_c, idp_d, idp_p,
+  idp_t1, idp_t2, idp_t3, idp_t4, idp_t5;
+-- a limit of 1 would not allow building any joins
+SET join_search_dp_limit = 1;
+
+-- inner joins, taking several rounds
+SELECT $$
+SELECT count(*), sum(a1.a + a2.a + b.a + c.a + d.a + a3.a)
+FROM idp_a a1
+  JOIN idp_a a2 ON a1.a = a2.a
+  JOIN idp_b b ON b.a = a2.a
+  JOIN idp_c c ON c.a > b.a
+  JOIN idp_d d ON d.a = b.a
+  JOIN idp_a a3 ON a3.a = c.a - d.a
+$$ AS qry \gset
+:qry;
+SET join_search_dp_limit = 3;
+:qry;
+RESET join_search_dp_limit;
+
+-- a chain of inner joins taking two rounds.  With only nested loops allowed,
+-- the cheapest plan joins the tables in order of size, and the first round
+-- must commit to the join of the three smallest.
+SET enable_hashjoin = off;
+SET enable_mergejoin = off;
+SET enable_material = off;
+SET join_search_dp_limit = 3;
+SELECT $$
+SELECT t1.x, t5.y
+FROM idp_t1 t1
+  JOIN idp_t2 t2 ON t1.x = t2.y
+  JOIN idp_t3 t3 ON t2.x = t3.y
+  JOIN idp_t4 t4 ON t3.x = t4.y
+  JOIN idp_t5 t5 ON t4.x = t5.y
+$$ AS qry \gset
+EXPLAIN (COSTS OFF)
+:qry;
+:qry;
+RESET join_search_dp_limit;
+RESET enable_hashjoin;
+RESET enable_mergejoin;
+RESET enable_material;
+
+-- outer join whose inner side must be joined first
+SELECT $$
+SELECT a.a, b.a AS b, c.a AS c
+FROM idp_a a
+  LEFT JOIN (idp_b b JOIN idp_c c ON b.a = c.a) ON a.a = b.a
+  JOIN idp_d d ON d.a = a.a
+  JOIN idp_a a2 ON a2.a = d.a + 1
+ORDER BY a.a
+$$ AS qry \gset
+:qry;
+SET join_search_dp_limit = 3;
+:qry;
+RESET join_search_dp_limit;
+
+-- semi and anti joins
+SELECT $$
+SELECT a.a
+FROM idp_a a
+  JOIN idp_d d ON a.a = d.a
+  JOIN idp_a a2 ON a2.a = a.a
+WHERE EXISTS (SELECT 1 FROM idp_b b WHERE b.a = a.a)
+  AND NOT EXISTS (SELECT 1 FROM idp_c c WHERE c.a = d.a)
+ORDER BY a.a
+$$ AS qry \gset
+:qry;
+SET join_search_dp_limit = 3;
+:qry;
+RESET join_search_dp_limit;
+
+-- lateral reference
+SELECT $$
+SELECT d.a, l.x
+FROM idp_d d
+  JOIN idp_a a ON a.a = d.a
+  JOIN idp_b b ON b.a = a.a,
+  LATERAL (SELECT c.a + d.a AS x FROM idp_c c WHERE c.a > d.a OFFSET 0) l
+ORDER BY d.a, l.x
+$$ AS qry \gset
+:qry;
+SET join_search_dp_limit = 3;
+:qry;
+RESET join_search_dp_limit;
+SET enable_partitionwise_join = on;
+
+-- partitionwise joins, whose child joins are rebuilt in later rounds
+SELECT $$
+SELECT t1.a, count(*)
+FROM idp_p t1
+  JOIN idp_p t2 ON t1.a = t2.a
+  JOIN idp_p t3 ON t2.a = t3.a
+  JOIN idp_p t4 ON t3.a = t4.a
+  JOIN idp_b b ON b.a = t4.a
+GROUP BY t1.a
+ORDER BY t1.a
+$$ AS qry \gset
+:qry;
+SET join_search_dp_limit = 3;
+:qry;
+RESET join_search_dp_limit;
+
+-- the plan is partitionwise even though the join of t1 and t2 is committed
+-- to before t3 is joined to it
+SET enable_hashjoin = off;
+SET enable_mergejoin = off;
+SET enable_material = off;
+SET join_search_dp_limit = 2;
+EXPLAIN (COSTS OFF)
+SELECT t1.a
+FROM idp_p t1
+  JOIN idp_p t2 ON t1.a = t2.a
+  JOIN idp_p t3 ON t2.a = t3.a;
+RESET join_search_dp_limit;
+RESET enable_hashjoin;
+RESET enable_mergejoin;
+RESET enable_material;
+RESET enable_partitionwise_join;
+
+DROP TABLE idp_p;
@@ -414,3 +414,21 @@ SELECT test_relpath();
 
 -- pg_replication_origin.roname limit
 SELECT pg_replication_origin_create('regress_' || repeat('a', 505));
+
+-- pg_session_state
+SELECT 'advisory_locks' = ANY(pg_session_state()) AS has_locks;
+SELECT pg_advisory_lock(4242);
+SELECT 'advisory_locks' = ANY(pg_session_state()) AS has_locks;
+SELECT pg_advisory_unlock(4242);
+SELECT 'advisory_locks' = ANY(pg_session_state()) AS has_locks;
+BEGIN;
+SELECT pg_advisory_xact_lock(4242);
+SELECT 'advisory_locks' = ANY(pg_session_state()) AS has_locks;
+COMMIT;
+SET extra_float_digits = 2;
+SELECT 'settings' = ANY(pg_session_state()) AS has_settings;
+RESET extra_float_digits;
+PREPARE session_state_stmt AS SELECT 1;
+SELECT 'prepared_statements' = ANY(pg_session_state()) AS has_prepared;
+DEALLOCATE session_state_stmt;
+SELECT 'prepared_statements' = ANY(pg_session_state()) AS has_prepared;
@@ -524,6 +524,29 @@ deallocate hp_q1;
 
 drop table hp;
 
+-- Run-time pruning of partitions that the planner didn't prune already,
+-- here rp2 and rp5.  The results must be the same as without any pruning.
+create table rp (a int, b int) partition by list (a);
+create table rp1 partition of rp for values in (1);
+create table rp2 partition of rp for values in (2);
+create table rp3 partition of rp for values in (3);
+create table rp4 partition of rp for values in (4);
+create table rp5 partition of rp for values in (5);
+insert into rp values (1, 1), (2, 2), (3, 3), (4, 4), (5, 5),
+  (1, 11), (2, 12), (3, 13), (4, 14), (5, 15);
+
+prepare rp_q1 (int) as
+select * from rp where a in (1, 3, 4) and a >= $1;
+
+explain (costs off) execute rp_q1 (3);
+execute rp_q1 (3);
+explain (costs off) execute rp_q1 (1);
+execute rp_q1 (1);
+
+deallocate rp_q1;
+
+drop table rp;
+
 -- Test a backwards Append scan
 create table list_part (a int) partition by list (a);
 create table list_part1 partition of list_part for values in (1);
@@ -39,6 +39,27 @@ VACUUM (PARALLEL 4, INDEX_CLEANUP ON) parallel_vacuum_table;
 -- assertion failure with bug #17245 (in the absence of bugfix):
 INSERT INTO parallel_vacuum_table SELECT i FROM generate_series(1, 10000) i;
 
+-- Parallel VACUUM sharing the second heap pass with the workers.  Setting
+-- min_parallel_table_scan_size to 0 makes the workers take part however few
+-- heap pages have dead items, and the table spans several of the chunks of
+-- blocks that the participants claim.
+SET min_parallel_table_scan_size TO 0;
+CREATE TABLE parallel_vacuum_heap (a int) WITH (autovacuum_enabled = off);
+INSERT INTO parallel_vacuum_heap SELECT i FROM generate_series(1, 200000) i;
+CREATE INDEX parallel_vacuum_heap_a ON parallel_vacuum_heap (a);
+CREATE INDEX parallel_vacuum_heap_a1 ON parallel_vacuum_heap ((a + 1));
+CREATE INDEX parallel_vacuum_heap_a2 ON parallel_vacuum_heap ((a + 2));
+DELETE FROM parallel_vacuum_heap WHERE a % 3 = 0;
+VACUUM (PARALLEL 4) parallel_vacuum_heap;
+SELECT count(*), sum(a) FROM parallel_vacuum_heap;
+SET enable_seqscan TO off;
+SET enable_bitmapscan TO off;
+SELECT count(*) FROM parallel_vacuum_heap WHERE a > 0;
+SELECT count(*) FROM parallel_vacuum_heap WHERE a + 1 > 1;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+RESET min_parallel_table_scan_size;
+
 RESET max_parallel_maintenance_workers;
 RESET min_parallel_index_scan_size;
 